@@ -0,0 +1,219 @@
+#ifndef NDRNP_ANYTIME_H
+#define NDRNP_ANYTIME_H
+
+#include <vector>
+#include <set>
+#include <random>
+#include <atomic>
+#include <chrono>
+#include <algorithm>   // shuffle(), max()
+#include <stdexcept>
+
+#include "header.h"
+#include "topology.h"
+#include "cover_strategy.h"
+#include "placement.h"
+
+namespace ndrnp {
+    // type declarations.
+    class CancelToken;
+    enum class anytime_phase: uint8_t;
+    struct AnytimeProgress;
+    struct RandomRestart;
+
+    // function declarations.
+    template <class Strategy, class Callback, class Restart>
+    std::set<size_type> anytime_placement(const Topology&, const Strategy&,
+                                          Workspace&,
+                                          const std::chrono::milliseconds&,
+                                          const CancelToken*, Callback,
+                                          const unsigned&, const Restart&);
+    template <class Strategy, class Callback>
+    std::set<size_type> anytime_placement(const Topology&, const Strategy&,
+                                          Workspace&,
+                                          const std::chrono::milliseconds&,
+                                          const CancelToken*, Callback,
+                                          const unsigned& = 0);
+
+    /* @class CancelToken
+     * Flag another thread raises to stop an anytime solve early.
+     */
+    class CancelToken {
+    public:
+        CancelToken(): flag(false) {}
+        CancelToken(const CancelToken&) = delete;
+        CancelToken& operator=(const CancelToken&) = delete;
+
+        void cancel() { flag.store(true); }
+        bool cancelled() const { return flag.load(); }
+
+    private:
+        std::atomic<bool>    flag;
+    };
+
+    /* @enum anytime_phase
+     * Phase of an anytime solve reported to its callback, i.e.:
+     * 0 - the layered cover found the first placement,
+     * 1 - pruning removed a relay of the incumbent,
+     * 2 - a randomized restart found a smaller placement,
+     * 3 - the solve stops, returning the incumbent.
+     */
+    enum class anytime_phase: uint8_t {
+        COVERED,
+        PRUNED,
+        RESTARTED,
+        DONE
+    };
+
+    /* @struct AnytimeProgress
+     * State of an anytime solve: the number of relays of the
+     * incumbent placement, the number of restarts run so far and
+     * the time spent.
+     */
+    struct AnytimeProgress {
+        anytime_phase                phase;
+        size_type                    relays;
+        size_type                    restarts;
+        std::chrono::milliseconds    elapsed;
+    };
+
+    /* @struct RandomRestart
+     * Default restart of anytime_placement(): a randomized cover of
+     * the given number of runs, on the calling thread, within the
+     * time left.
+     */
+    struct RandomRestart {
+        explicit RandomRestart(const size_type& r = 8): runs(r) {}
+
+        RandomStrategy operator()(const unsigned& seed,
+                                  const std::chrono::milliseconds& left) const {
+            return RandomStrategy(runs, seed, 1, left);
+        }
+
+        size_type    runs;
+    };
+
+    /* @fn anytime_placement()
+     * Relay placement with a time budget. The layered cover (see
+     * cover_layers()) gives a first placement, which is then pruned
+     * relay by relay; while time is left, randomized restarts (a
+     * randomized cover of every layer and pruning in random order)
+     * are run and replace the incumbent whenever they need fewer
+     * relays. The budget and the token are checked between pruning
+     * steps and restarts; the first cover always runs to completion,
+     * as does each layer of a restart, whose randomized covers are
+     * limited to the remaining time.
+     * callback(progress, incumbent) is called whenever the
+     * incumbent changes, and once when the solve stops.
+     * @param budget time budget, zero for none; without a budget
+     * and a token no restart is run.
+     * @param token cancellation token, or nullptr.
+     * @param restart function giving the strategy of a restart from a
+     * seed and the time left (zero without a budget, at least 1 ms
+     * otherwise); see RandomRestart.
+     * @return ids of the relays of the incumbent, or an empty set if
+     * no relay is needed or no placement is found. ws is left in the
+     * state of the last restart, not necessarily the incumbent's.
+     */
+    template <class Strategy, class Callback, class Restart>
+    std::set<size_type>
+    anytime_placement(const Topology& topo, const Strategy& strategy,
+                      Workspace& ws, const std::chrono::milliseconds& budget,
+                      const CancelToken* token, Callback callback,
+                      const unsigned& seed, const Restart& restart) {
+        typedef std::chrono::steady_clock    clock_type;
+
+        const clock_type::time_point start = clock_type::now();
+        std::set<size_type>          best;
+        std::vector<size_type>       order;
+        AnytimeProgress              progress{anytime_phase::COVERED, 0, 0,
+                                              std::chrono::milliseconds::zero()};
+
+        auto remaining = [&]() {
+            return budget - std::chrono::duration_cast<std::chrono::milliseconds>(
+                                clock_type::now() - start);
+        };
+        auto stopped = [&]() {
+            return (token != nullptr && token->cancelled()) ||
+                   (budget != std::chrono::milliseconds::zero() &&
+                    remaining() <= std::chrono::milliseconds::zero());
+        };
+        auto report = [&](const anytime_phase& phase) {
+            progress.phase = phase;
+            progress.relays = best.size();
+            progress.elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+                                   clock_type::now() - start);
+            callback(progress, best);
+        };
+
+        if (!cover_layers(topo, strategy, ws)) {
+            report(anytime_phase::DONE);
+            return best;
+        }
+        best = placed_relays(topo, ws);
+        report(anytime_phase::COVERED);
+        if (!strategy.prune()) {
+            report(anytime_phase::DONE);
+            return best;
+        }
+
+        // pruning can stop at any step, the active relays are a valid
+        // placement after each of them.
+        for (size_type i = 0; i < topo.size() && !stopped(); ++i)
+            if (ws.selected[i] && prune_relay(topo, ws, i)) {
+                best.erase(topo.id(i));
+                report(anytime_phase::PRUNED);
+            }
+
+        // without a budget or a token, restarts would never stop.
+        std::default_random_engine e(seed);
+        bool bounded = budget != std::chrono::milliseconds::zero() || token != nullptr;
+        while (bounded && !stopped()) {
+            // a zero budget would mean no limit to the restart.
+            std::chrono::milliseconds left = budget == std::chrono::milliseconds::zero() ?
+                                             budget :
+                                             std::max(remaining(), std::chrono::milliseconds(1));
+            // the first cover needed relays, so a restart failing to
+            // cover only gives up on that layer.
+            bool covered = cover_layers(topo, restart(e(), left), ws);
+            ++progress.restarts;
+            if (!covered)
+                continue;
+            order.clear();
+            for (size_type i = 0; i < topo.size(); ++i)
+                if (ws.selected[i])
+                    order.push_back(i);
+            std::shuffle(order.begin(), order.end(), e);
+
+            size_type relays = order.size();
+            for (auto &i : order) {
+                if (stopped())
+                    break;
+                if (prune_relay(topo, ws, i))
+                    --relays;
+            }
+            // an interrupted restart is valid too.
+            if (relays < best.size()) {
+                best = placed_relays(topo, ws);
+                report(anytime_phase::RESTARTED);
+            }
+        }
+        report(anytime_phase::DONE);
+        return best;
+    }
+
+    /* @fn anytime_placement()
+     * As above, restarting with RandomRestart().
+     */
+    template <class Strategy, class Callback>
+    std::set<size_type>
+    anytime_placement(const Topology& topo, const Strategy& strategy,
+                      Workspace& ws, const std::chrono::milliseconds& budget,
+                      const CancelToken* token, Callback callback,
+                      const unsigned& seed) {
+        return anytime_placement(topo, strategy, ws, budget, token, callback, seed,
+                                 RandomRestart());
+    }
+}
+
+#endif
@@ -0,0 +1,215 @@
+#ifndef NDRNP_BITSET_H
+#define NDRNP_BITSET_H
+
+#include <vector>
+#include <cstdint>     // uint64_t
+#include <functional>  // hash
+
+#include "header.h"
+
+namespace ndrnp {
+    // type declarations.
+    class Bitset;
+    struct BitsetHash;
+
+    /* @class Bitset
+     * A dynamically sized set of bits, used to represent sets over
+     * a small dense universe (element indices of a cover instance,
+     * vertex indices of a graph). Bits beyond size() are always zero.
+     */
+    class Bitset {
+    public:
+        typedef uint64_t    word_type;
+
+        static const size_type WORD_BITS = 64;
+        static const size_type npos = static_cast<size_type>(-1);
+
+        Bitset(): _size(0) {}
+        explicit Bitset(const size_type& n)
+        : _size(n), _words((n + WORD_BITS - 1) / WORD_BITS, 0) {}
+
+        bool operator==(const Bitset& b) const {
+            return _size == b._size && _words == b._words;
+        }
+        bool operator!=(const Bitset& b) const { return !(*this == b); }
+
+        Bitset& operator&=(const Bitset&);
+        Bitset& operator|=(const Bitset&);
+        // remove every bit that is set in given bitset.
+        Bitset& subtract(const Bitset&);
+
+        bool test(const size_type& i) const {
+            return (_words[i / WORD_BITS] >> (i % WORD_BITS)) & 1u;
+        }
+        void set(const size_type& i) {
+            _words[i / WORD_BITS] |= word_type(1) << (i % WORD_BITS);
+        }
+        void reset(const size_type& i) {
+            _words[i / WORD_BITS] &= ~(word_type(1) << (i % WORD_BITS));
+        }
+        void set_all();
+        void reset_all();
+        // resize to n bits, clearing every bit.
+        void assign(const size_type&);
+
+        size_type size() const { return _size; }
+        size_type count() const;
+        bool      any() const;
+        bool      none() const { return !any(); }
+
+        // number of bits set in both this and given bitset.
+        size_type intersect_count(const Bitset&) const;
+        bool      intersects(const Bitset&) const;
+        // true if every bit of this bitset is set in given bitset.
+        bool      is_subset_of(const Bitset&) const;
+        // true if every bit of this bitset that is also in mask
+        // is set in given bitset.
+        bool      is_subset_of(const Bitset&, const Bitset&) const;
+
+        // index of the first set bit at or after i, npos if none.
+        size_type find_next(const size_type&) const;
+        size_type find_first() const { return find_next(0); }
+
+        size_type hash() const;
+
+        const std::vector<word_type>& words() const { return _words; }
+
+    private:
+        static size_type popcount(word_type w) {
+            return __builtin_popcountll(w);
+        }
+
+    private:
+        size_type                _size;
+        std::vector<word_type>   _words;
+    };
+
+    const size_type Bitset::WORD_BITS;
+    const size_type Bitset::npos;
+
+    Bitset&
+    Bitset::operator&=(const Bitset& b) {
+        for (size_type i = 0; i < _words.size(); ++i)
+            _words[i] &= b._words[i];
+        return *this;
+    }
+
+    Bitset&
+    Bitset::operator|=(const Bitset& b) {
+        for (size_type i = 0; i < _words.size(); ++i)
+            _words[i] |= b._words[i];
+        return *this;
+    }
+
+    Bitset&
+    Bitset::subtract(const Bitset& b) {
+        for (size_type i = 0; i < _words.size(); ++i)
+            _words[i] &= ~b._words[i];
+        return *this;
+    }
+
+    void
+    Bitset::set_all() {
+        for (auto &w : _words)
+            w = ~word_type(0);
+        if (_size % WORD_BITS)
+            _words.back() &= (word_type(1) << (_size % WORD_BITS)) - 1;
+    }
+
+    void
+    Bitset::reset_all() {
+        for (auto &w : _words)
+            w = 0;
+    }
+
+    void
+    Bitset::assign(const size_type& n) {
+        _size = n;
+        // assign() keeps the capacity of _words, so reusing a bitset
+        // for instances of similar size does not allocate.
+        _words.assign((n + WORD_BITS - 1) / WORD_BITS, 0);
+    }
+
+    size_type
+    Bitset::count() const {
+        size_type c = 0;
+        for (auto &w : _words)
+            c += popcount(w);
+        return c;
+    }
+
+    bool
+    Bitset::any() const {
+        for (auto &w : _words)
+            if (w)
+                return true;
+        return false;
+    }
+
+    size_type
+    Bitset::intersect_count(const Bitset& b) const {
+        size_type c = 0;
+        for (size_type i = 0; i < _words.size(); ++i)
+            c += popcount(_words[i] & b._words[i]);
+        return c;
+    }
+
+    bool
+    Bitset::intersects(const Bitset& b) const {
+        for (size_type i = 0; i < _words.size(); ++i)
+            if (_words[i] & b._words[i])
+                return true;
+        return false;
+    }
+
+    bool
+    Bitset::is_subset_of(const Bitset& b) const {
+        for (size_type i = 0; i < _words.size(); ++i)
+            if (_words[i] & ~b._words[i])
+                return false;
+        return true;
+    }
+
+    bool
+    Bitset::is_subset_of(const Bitset& b, const Bitset& mask) const {
+        for (size_type i = 0; i < _words.size(); ++i)
+            if (_words[i] & mask._words[i] & ~b._words[i])
+                return false;
+        return true;
+    }
+
+    size_type
+    Bitset::find_next(const size_type& i) const {
+        if (i >= _size)
+            return npos;
+        size_type    w = i / WORD_BITS;
+        word_type    cur = _words[w] & (~word_type(0) << (i % WORD_BITS));
+
+        while (true) {
+            if (cur)
+                return w * WORD_BITS + __builtin_ctzll(cur);
+            if (++w == _words.size())
+                return npos;
+            cur = _words[w];
+        }
+    }
+
+    size_type
+    Bitset::hash() const {
+        size_type h = std::hash<size_type>()(_size);
+        // boost::hash_combine style mixing of every word.
+        for (auto &w : _words)
+            h ^= std::hash<word_type>()(w) + 0x9e3779b97f4a7c15ull +
+                 (h << 6) + (h >> 2);
+        return h;
+    }
+
+    /* @struct BitsetHash
+     * Hash functor for unordered containers keyed on a Bitset.
+     */
+    struct BitsetHash {
+        size_type operator()(const Bitset& b) const { return b.hash(); }
+    };
+}
+
+#endif
@@ -0,0 +1,144 @@
+#ifndef NDRNP_CANDIDATES_H
+#define NDRNP_CANDIDATES_H
+
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <tuple>
+#include <algorithm>   // sort()
+#include <cmath>       // floor()
+#include <functional>  // hash
+
+#include "header.h"
+#include "node.h"
+#include "topology.h"
+
+/*
+ * Merging of equivalent candidate deployment locations, so that
+ * clusters of nearly identical CDLs count once in the graph and in
+ * the cover families.
+ */
+
+namespace ndrnp {
+    // type declarations.
+    struct CandidateClasses;
+
+    // function declarations.
+    CandidateClasses merge_candidates(Topology&);
+    std::vector<Node*> snap_candidates(const std::vector<Node*>&, const coordinate_type&,
+                                       CandidateClasses&);
+
+    /* @struct CandidateClasses
+     * Classes of merged CDLs: rep[i] is the position of the node
+     * standing for node i (i itself for every node kept), in the
+     * node set given to merge_candidates() or snap_candidates().
+     */
+    struct CandidateClasses {
+        // positions of the nodes node r stands for, r included.
+        std::vector<size_type> members(const size_type& r) const {
+            std::vector<size_type> res;
+            for (size_type i = 0; i < rep.size(); ++i)
+                if (rep[i] == r)
+                    res.push_back(i);
+            return res;
+        }
+
+        std::vector<size_type>    rep;
+        size_type                 merged = 0;
+    };
+
+    /* @fn merge_candidates()
+     * Merge the CDLs of topo having the same links: the same nodes
+     * reaching them and reached by them, each counting itself, so
+     * that co-located CDLs, which reach one another, fall into one
+     * class. Such CDLs are interchangeable in every cover, so only
+     * the first of each class is kept and the others are removed
+     * from topo (see Topology::remove()).
+     * Candidates are grouped by a hash of their sorted link lists,
+     * then compared exactly within a group.
+     */
+    CandidateClasses
+    merge_candidates(Topology& topo) {
+        typedef std::pair<std::vector<size_type>, std::vector<size_type>>  links_type;
+
+        CandidateClasses                                          cls;
+        std::unordered_map<size_type, std::vector<size_type>>     groups;
+        std::vector<links_type>                                   links(topo.size());
+        std::vector<size_type>                                    dups;
+
+        auto closed = [](std::vector<size_type> l, const size_type& i) {
+            l.push_back(i);
+            std::sort(l.begin(), l.end());
+            return l;
+        };
+        auto hash = [](const std::vector<size_type>& l, size_type h) {
+            // boost::hash_combine style mixing, as Bitset::hash().
+            for (auto &v : l)
+                h ^= std::hash<size_type>()(v) + 0x9e3779b97f4a7c15ull +
+                     (h << 6) + (h >> 2);
+            return h;
+        };
+
+        cls.rep.resize(topo.size());
+        for (size_type i = 0; i < topo.size(); ++i) {
+            cls.rep[i] = i;
+            if (topo.type(i) != NodeType::CDL || topo.removed(i))
+                continue;
+            links[i] = std::make_pair(closed(topo.out(i), i), closed(topo.in(i), i));
+            std::vector<size_type>& g = groups[hash(links[i].second,
+                                                   hash(links[i].first, 0))];
+            for (auto &j : g)
+                if (links[j] == links[i]) {
+                    cls.rep[i] = j;
+                    break;
+                }
+            if (cls.rep[i] == i)
+                g.push_back(i);
+            else
+                dups.push_back(i);
+        }
+        topo.remove(dups);
+        cls.merged = dups.size();
+        return cls;
+    }
+
+    /* @fn snap_candidates()
+     * Merge the CDLs of nds falling into the same cell of a grid of
+     * the given side (and having the same power), keeping the first
+     * of each cell, before any graph is built. Unlike
+     * merge_candidates() this changes the instance: a kept CDL stands
+     * for locations up to a cell diagonal away.
+     * @return the nodes kept, in their order in nds; classes are
+     * filled in with positions in nds. Nothing of nds is modified.
+     */
+    std::vector<Node*>
+    snap_candidates(const std::vector<Node*>& nds, const coordinate_type& cell,
+                    CandidateClasses& cls) {
+        typedef std::tuple<long, long, long, Node::power_type>    key_type;
+
+        std::map<key_type, size_type>    first;
+        std::vector<Node*>               res;
+
+        cls.rep.resize(nds.size());
+        cls.merged = 0;
+        for (size_type i = 0; i < nds.size(); ++i) {
+            cls.rep[i] = i;
+            if (nds[i]->type() == NodeType::CDL && cell > 0.0) {
+                const Coordinate c = nds[i]->coordinate();
+                key_type k(std::floor(c.x() / cell), std::floor(c.y() / cell),
+                           std::floor(c.z() / cell), nds[i]->power());
+                auto it = first.find(k);
+                if (it != first.end()) {
+                    cls.rep[i] = it->second;
+                    ++cls.merged;
+                    continue;
+                }
+                first.emplace(k, i);
+            }
+            res.push_back(nds[i]);
+        }
+        return res;
+    }
+}
+
+#endif
@@ -4,123 +4,153 @@
 #include <iostream>
 #include <utility>
 #include <cmath>
+#include <cstddef>     // size_t
+#include <stdexcept>
 
 namespace ndrnp {
     // type declarations.
-    class Coordinate;
+    template <std::size_t N, class T>
+    class BasicCoordinate;
 
-    // function declarations.
+    // a point in 3-D space, as every node carries.
+    typedef BasicCoordinate<3, double>    Coordinate;
+    // a point in the plane, for deployments where every z is 0.
+    typedef BasicCoordinate<2, double>    Coordinate2D;
+    typedef BasicCoordinate<2, float>     Coordinate2F;
+    typedef BasicCoordinate<3, float>     Coordinate3F;
 
-    /* @class Coordinate
-     * The coordinate of a point in 3-D Euclidean space.
+    // function declarations.
+    template <std::size_t N, class T>
+    T squared_distance(const BasicCoordinate<N, T>&, const BasicCoordinate<N, T>&);
+    template <std::size_t N, class T>
+    T distance(const BasicCoordinate<N, T>&, const BasicCoordinate<N, T>&);
+
+    /* @class BasicCoordinate
+     * The coordinate of a point in N-D (2-D or 3-D) Euclidean space,
+     * of scalar type T. A 2-D point stores no z, which reads as 0;
+     * only 0 may be given as its z.
      */
-    class Coordinate {
+    template <std::size_t N, class T>
+    class BasicCoordinate {
+        static_assert(N == 2 || N == 3, "Only 2-D and 3-D coordinates are supported");
     public:
-        typedef double    coordinate_type;
+        typedef T    coordinate_type;
+
+        static const std::size_t dimension = N;
 
-        Coordinate(const coordinate_type& x = 0.0,
-                   const coordinate_type& y = 0.0,
-                   const coordinate_type& z = 0.0)
-        : _x(x), _y(y), _z(z) {}
+        BasicCoordinate(const coordinate_type& x = 0.0,
+                        const coordinate_type& y = 0.0,
+                        const coordinate_type& z = 0.0)
+        : _c{x, y} { setZ(z); }
 
-        Coordinate(const Coordinate&);
-        Coordinate(Coordinate&&);
+        BasicCoordinate(const BasicCoordinate&) = default;
+        BasicCoordinate(BasicCoordinate&&) = default;
 
-        Coordinate& operator=(const Coordinate&);
-        Coordinate& operator=(Coordinate&&);
+        BasicCoordinate& operator=(const BasicCoordinate&) = default;
+        BasicCoordinate& operator=(BasicCoordinate&&) = default;
 
-        Coordinate& operator+=(const Coordinate&);
-        Coordinate& operator-=(const Coordinate&);
+        BasicCoordinate& operator+=(const BasicCoordinate&);
+        BasicCoordinate& operator-=(const BasicCoordinate&);
 
-        Coordinate operator+(const Coordinate&) const;
-        Coordinate operator-(const Coordinate&) const;
+        BasicCoordinate operator+(const BasicCoordinate&) const;
+        BasicCoordinate operator-(const BasicCoordinate&) const;
 
-        bool operator==(const Coordinate&) const;
-        bool operator!=(const Coordinate&) const;
+        bool operator==(const BasicCoordinate&) const;
+        bool operator!=(const BasicCoordinate&) const;
 
-        bool operator>(const Coordinate&) const = delete;
-        bool operator>=(const Coordinate&) const = delete;
-        bool operator<(const Coordinate&) const = delete;
-        bool operator<=(const Coordinate&) const = delete;
+        bool operator>(const BasicCoordinate&) const = delete;
+        bool operator>=(const BasicCoordinate&) const = delete;
+        bool operator<(const BasicCoordinate&) const = delete;
+        bool operator<=(const BasicCoordinate&) const = delete;
 
-        coordinate_type x() const { return _x; }
-        coordinate_type y() const { return _y; }
-        coordinate_type z() const { return _z; }
+        coordinate_type x() const { return _c[0]; }
+        coordinate_type y() const { return _c[1]; }
+        coordinate_type z() const { return N == 3 ? _c[N - 1] : coordinate_type(0); }
+        // the i-th component, i < N.
+        coordinate_type operator[](const std::size_t& i) const { return _c[i]; }
 
-        void setX(const coordinate_type& x) { _x = x; }
-        void setY(const coordinate_type& y) { _y = y; }
-        void setZ(const coordinate_type& z) { _z = z; }
+        void setX(const coordinate_type& x) { _c[0] = x; }
+        void setY(const coordinate_type& y) { _c[1] = y; }
+        // @throw std::range_error if z is not 0 for a 2-D point.
+        void setZ(const coordinate_type&);
     private:
-        coordinate_type    _x;
-        coordinate_type    _y;
-        coordinate_type    _z;
+        coordinate_type    _c[N];
     };
 
-    Coordinate::Coordinate(const Coordinate& coor)
-    : _x(coor._x), _y(coor._y), _z(coor._z) {}
-    Coordinate::Coordinate(Coordinate&& coor)
-    : _x(std::move(coor._x)), _y(std::move(coor._y)),
-      _z(std::move(coor._z)) {}
-
-    Coordinate&
-    Coordinate::operator=(const Coordinate& co) {
-        _x = co._x; _y = co._y; _z = co._z;
-        return *this;
-    }
-    Coordinate&
-    Coordinate::operator=(Coordinate&& co) {
-        _x = std::move(co._x);
-        _y = std::move(co._y);
-        _z = std::move(co._z);
-        return *this;
+    template <std::size_t N, class T>
+    void
+    BasicCoordinate<N, T>::setZ(const coordinate_type& z) {
+        if (N == 3)
+            _c[N - 1] = z;
+        else if (z != coordinate_type(0))
+            throw std::range_error("A 2-D coordinate has no z");
     }
 
-    Coordinate&
-    Coordinate::operator+=(const Coordinate& rhs) {
-        _x += rhs._x; _y += rhs._y; _z += rhs._z;
+    template <std::size_t N, class T>
+    BasicCoordinate<N, T>&
+    BasicCoordinate<N, T>::operator+=(const BasicCoordinate& rhs) {
+        for (std::size_t i = 0; i < N; ++i)
+            _c[i] += rhs._c[i];
         return *this;
     }
-    Coordinate&
-    Coordinate::operator-=(const Coordinate& rhs) {
-        _x -= rhs._x; _y -= rhs._y; _z -= rhs._z;
+    template <std::size_t N, class T>
+    BasicCoordinate<N, T>&
+    BasicCoordinate<N, T>::operator-=(const BasicCoordinate& rhs) {
+        for (std::size_t i = 0; i < N; ++i)
+            _c[i] -= rhs._c[i];
         return *this;
     }
 
-    Coordinate
-    Coordinate::operator+(const Coordinate& rhs) const {
-        return Coordinate(_x + rhs._x, _y + rhs._y,
-                          _z + rhs._z);
+    template <std::size_t N, class T>
+    BasicCoordinate<N, T>
+    BasicCoordinate<N, T>::operator+(const BasicCoordinate& rhs) const {
+        BasicCoordinate res(*this);
+        return res += rhs;
     }
-    Coordinate
-    Coordinate::operator-(const Coordinate& rhs) const {
-        return Coordinate(_x - rhs._x, _y - rhs._y,
-                          _z - rhs._z);
+    template <std::size_t N, class T>
+    BasicCoordinate<N, T>
+    BasicCoordinate<N, T>::operator-(const BasicCoordinate& rhs) const {
+        BasicCoordinate res(*this);
+        return res -= rhs;
     }
 
+    template <std::size_t N, class T>
     bool
-    Coordinate::operator==(const Coordinate& rhs) const {
-        return _x == rhs._x && _y == rhs._y && _z == rhs._z;
+    BasicCoordinate<N, T>::operator==(const BasicCoordinate& rhs) const {
+        for (std::size_t i = 0; i < N; ++i)
+            if (_c[i] != rhs._c[i])
+                return false;
+        return true;
     }
+    template <std::size_t N, class T>
     bool
-    Coordinate::operator!=(const Coordinate& rhs) const {
+    BasicCoordinate<N, T>::operator!=(const BasicCoordinate& rhs) const {
         return !(*this == rhs);
     }
 
     // function definitions.
-    Coordinate::coordinate_type
-    distance(const Coordinate& c1, const Coordinate& c2) {
-        Coordinate::coordinate_type x, y, z;
-
-        x = std::fabs(c1.x() - c2.x());
-        y = std::fabs(c1.y() - c2.y());
-        z = std::fabs(c1.z() - c2.z());
+    /* @fn squared_distance()
+     * Squared Euclidean distance between two points, for comparing
+     * distances (e.g. against a squared link range) without a sqrt.
+     */
+    template <std::size_t N, class T>
+    T
+    squared_distance(const BasicCoordinate<N, T>& c1, const BasicCoordinate<N, T>& c2) {
+        T d = 0;
+        for (std::size_t i = 0; i < N; ++i)
+            d += (c1[i] - c2[i]) * (c1[i] - c2[i]);
+        return d;
+    }
 
-        return std::sqrt(std::pow(x, 2) + std::pow(y, 2) +
-                         std::pow(z, 2));
+    template <std::size_t N, class T>
+    T
+    distance(const BasicCoordinate<N, T>& c1, const BasicCoordinate<N, T>& c2) {
+        return std::sqrt(squared_distance(c1, c2));
     }
 
+    template <std::size_t N, class T>
     std::ostream&
-    operator<<(std::ostream& os, const Coordinate& co) {
+    operator<<(std::ostream& os, const BasicCoordinate<N, T>& co) {
         os << "(" << co.x() << "," << co.y() << ","
            << co.z() << ")";
         return os;
@@ -3,17 +3,81 @@
 
 #include <set>
 #include <map>
+#include <vector>
+#include <algorithm>
 #include <utility>
 #include <initializer_list>
 #include <random>
 #include <ctime>
 #include <cstdlib>
-#include <cmath>     // abs()
+#include <cmath>
+#include <queue>
+#include <chrono>
+#include <atomic>
+#include <mutex>
+#include <future>
 
 #include "header.h"
 #include "miscellaneous.h"
+#include "thread_pool.h"
+#include "bitset.h"
+#include "exact_cover.h"
 
 namespace ndrnp {
+    /* @enum CoverMethod
+     * Algorithm used to cover each layer in the placement solvers:
+     * 0: greedy (ln(n)-approximate),
+     * 1: exact branch-and-bound, falling back to the best cover
+     *    found when its node or time limit is reached.
+     */
+    enum class CoverMethod: uint8_t {
+        GREEDY, EXACT
+    };
+
+    /* @struct CoverReduction
+     * Outcome of Cover::reduce(). Keys in forced belong to every
+     * cover of the original instance and must be added to the cover
+     * found for the reduced one. merged maps each kept key to the
+     * keys of identical sets that were dropped in its favour.
+     */
+    template <typename T>
+    struct CoverReduction {
+        std::set<T>                  forced;
+        std::map<T, std::set<T>>     merged;
+        size_type                    dominated = 0;
+        size_type                    sets_before = 0;
+        size_type                    sets_after = 0;
+        size_type                    elements_before = 0;
+        size_type                    elements_after = 0;
+
+        // fraction of the sets removed from the family.
+        double ratio() const {
+            return sets_before == 0 ? 0.0 :
+                   1.0 - static_cast<double>(sets_after) / sets_before;
+        }
+    };
+
+    /* @struct CoverIndex
+     * The family of a Cover in compressed rows, so that the greedy
+     * covers run over flat arrays instead of a copy of the family.
+     * Elements are numbered by rank in values; set i has key keys[i]
+     * and holds the elements numbered elems[begin[i]..begin[i + 1]),
+     * and element e lies in the sets numbered sets[at[e]..at[e + 1]).
+     * needed[e] tells whether element e is to be covered, i.e. is in
+     * _set; needs is the number of those.
+     */
+    template <typename T, typename K>
+    struct CoverIndex {
+        std::vector<T>            keys;
+        std::vector<size_type>    begin;
+        std::vector<size_type>    elems;
+        std::vector<K>            values;
+        std::vector<size_type>    at;
+        std::vector<size_type>    sets;
+        std::vector<char>         needed;
+        size_type                 needs = 0;
+    };
+
     template <typename T, typename K>
     class Cover {
     public:
@@ -46,30 +110,88 @@ namespace ndrnp {
         void insert_family(const key_type&, const std::set<value_type>&);
         void insert_family(const key_type&, const std::initializer_list<value_type>&);
         void insert_family(const key_type&, const value_type&);
+        // replace the family by the given (key, element) pairs, sorted
+        // by key, and the _set field by the given elements; the sorted
+        // pairs are inserted without a lookup each.
+        template <class PairIt, class ElemIt>
+        void assign(PairIt, PairIt, ElemIt, ElemIt);
 
-        std::map<key_type, std::set<value_type>> family() const { return _family; }
-        std::set<value_type> set() const { return _set; }
+        const std::map<key_type, std::set<value_type>>& family() const { return _family; }
+        const std::set<value_type>& set() const { return _set; }
+
+        // shrink the instance by forcing sets that are the only cover
+        // of an element, merging identical sets and removing dominated
+        // sets.
+        CoverReduction<key_type> reduce();
 
         // search a minimum set cover of _set field using _family field,
         // using the greedy algorithm.
         std::set<key_type> minimum_set_cover() const;
         std::set<key_type> weight_set_cover(const size_type&) const;
+        // search a minimum cost set cover of _set field using _family field,
+        // using the greedy algorithm with lazy evaluation.
+        std::set<key_type> cost_set_cover(const std::map<key_type, double>&) const;
         std::set<key_type> rrnp_msc(const std::set<size_type>&) const;
         std::set<key_type> random_set_cover(std::default_random_engine&,
                                     const std::set<size_type>&) const;
+        // run a number of randomized covers in parallel, each with an
+        // engine derived from the master seed, and keep the smallest one.
+        std::set<key_type> multi_random_set_cover(const size_type&, const unsigned&,
+                                    const size_type& = 0,
+                                    const std::chrono::milliseconds& =
+                                        std::chrono::milliseconds::zero()) const;
+        // search a minimum set cover of _set field using _family field,
+        // using branch-and-bound within given node and time limits.
+        std::set<key_type> exact_set_cover(const size_type& = EXACT_NODE_LIMIT,
+                                    const std::chrono::milliseconds& =
+                                        std::chrono::milliseconds::zero()) const;
+        // remove sets made redundant by the rest of given cover, and
+        // replace two sets by one where a single set does their job.
+        std::set<key_type> eliminate_redundant(const std::set<key_type>&) const;
         // search a minimum k-set cover of _set field using _family field,
         // using the greedy algorithm.
-//        std::set<key_type> k_set_cover(const size_type&);
+        std::set<key_type> k_set_cover(const size_type&) const;
         // search a random k-set cover of _set field using _family field,
         // using roulette wheel method.
-//        std::set<key_type> random_k_set_cover(std::default_random_engine&, const size_type&);
+        std::set<key_type> random_k_set_cover(std::default_random_engine&, const size_type&) const;
 
     private:
-        // return the key of the set with maximal size from given family.
-        key_type max_set(std::map<key_type, std::set<value_type>>&) const;
-        key_type max_weight_set(std::map<key_type, std::set<value_type>>&, const size_type&) const;
-        key_type random_set(std::default_random_engine&, 
-                            std::map<key_type, std::set<value_type>>&) const;
+        // what remains of the family during a greedy cover over an
+        // index: the uncovered elements of each set, the sets not yet
+        // taken and the covered elements.
+        struct Residual {
+            explicit Residual(const CoverIndex<key_type, value_type>&);
+            // take set i: cover its elements and drop it.
+            void take(const size_type&);
+
+            const CoverIndex<key_type, value_type>&    ix;
+            std::vector<size_type>                     gain;
+            std::vector<char>                          alive;
+            std::vector<char>                          covered;
+            size_type                                  left;
+            size_type                                  uncovered;
+        };
+
+        void index(CoverIndex<key_type, value_type>&) const;
+        // return the set of maximal size among the remaining ones.
+        size_type max_set(const Residual&) const;
+        size_type max_weight_set(const Residual&, const size_type&) const;
+        // draw a remaining set with probability growing with its gain,
+        // or return the number of sets if none gains anything.
+        size_type random_set(std::default_random_engine&, const Residual&) const;
+        // take sets of maximal size until every element is covered.
+        std::set<key_type> greedy_cover(Residual&, std::set<key_type>&) const;
+        std::set<key_type> random_cover(std::default_random_engine&,
+                                        const CoverIndex<key_type, value_type>&) const;
+        // index the elements of _set and the family restricted to them,
+        // and set each element's demand to min(k, number of its covers).
+        bool k_demand(const size_type&, std::vector<key_type>&,
+                      std::vector<std::vector<size_type>>&,
+                      std::vector<size_type>&) const;
+        // |a - b| without wrapping around for unsigned sizes.
+        static size_type size_distance(const size_type& a, const size_type& b) {
+            return a > b ? a - b : b - a;
+        }
 
     private:
         std::map<key_type, std::set<value_type>>    _family;
@@ -142,42 +264,239 @@ namespace ndrnp {
     }
 
     template <typename T, typename K>
-    T
-    Cover<T,K>::max_set(std::map<T, std::set<K>>& f) const {
-        bool flag = false;
-        T m;
+    template <class PairIt, class ElemIt>
+    void
+    Cover<T,K>::assign(PairIt first, PairIt last, ElemIt sfirst, ElemIt slast) {
+        auto it = _family.end();
+
+        _family.clear();
+        _set.clear();
+        for (; first != last; ++first) {
+            if (it == _family.end() || it->first != first->first)
+                it = _family.emplace_hint(_family.end(), first->first, std::set<K>());
+            it->second.emplace_hint(it->second.end(), first->second);
+        }
+        _set.insert(sfirst, slast);
+    }
+
+    /* @fn index()
+     * Fill ix from the family and _set (see CoverIndex), reusing its
+     * buffers.
+     */
+    template <typename T, typename K>
+    void
+    Cover<T,K>::index(CoverIndex<T,K>& ix) const {
+        ix.values.assign(_set.begin(), _set.end());
+        for (auto &f : _family)
+            ix.values.insert(ix.values.end(), f.second.begin(), f.second.end());
+        std::sort(ix.values.begin(), ix.values.end());
+        ix.values.erase(std::unique(ix.values.begin(), ix.values.end()), ix.values.end());
+        auto rank = [&ix](const K& e) {
+            return static_cast<size_type>(std::lower_bound(ix.values.begin(),
+                                              ix.values.end(), e) - ix.values.begin());
+        };
 
-        for (auto &s : f) {
-            if (!flag) {
-                flag = true;
-                m = s.first;
+        ix.needed.assign(ix.values.size(), 0);
+        for (auto &e : _set)
+            ix.needed[rank(e)] = 1;
+        ix.needs = _set.size();
+        ix.keys.clear();
+        ix.elems.clear();
+        ix.begin.assign(1, 0);
+        ix.at.assign(ix.values.size() + 1, 0);
+        for (auto &f : _family) {
+            ix.keys.push_back(f.first);
+            for (auto &e : f.second) {
+                ix.elems.push_back(rank(e));
+                ++ix.at[ix.elems.back() + 1];
+            }
+            ix.begin.push_back(ix.elems.size());
+        }
+        // the transpose: count, then fill each row from its start,
+        // which leaves at[e] at the start of row e + 1.
+        for (size_type e = 1; e < ix.at.size(); ++e)
+            ix.at[e] += ix.at[e - 1];
+        ix.sets.resize(ix.elems.size());
+        for (size_type i = 0; i < ix.keys.size(); ++i)
+            for (size_type p = ix.begin[i]; p < ix.begin[i + 1]; ++p)
+                ix.sets[ix.at[ix.elems[p]]++] = i;
+        for (size_type e = ix.at.size() - 1; e > 0; --e)
+            ix.at[e] = ix.at[e - 1];
+        ix.at[0] = 0;
+    }
+
+    template <typename T, typename K>
+    Cover<T,K>::Residual::Residual(const CoverIndex<T,K>& i)
+    : ix(i), alive(i.keys.size(), 1), covered(i.values.size(), 0),
+      left(i.keys.size()), uncovered(i.needs) {
+        gain.resize(ix.keys.size());
+        for (size_type s = 0; s < ix.keys.size(); ++s)
+            gain[s] = ix.begin[s + 1] - ix.begin[s];
+    }
+
+    template <typename T, typename K>
+    void
+    Cover<T,K>::Residual::take(const size_type& i) {
+        for (size_type p = ix.begin[i]; p < ix.begin[i + 1]; ++p) {
+            size_type e = ix.elems[p];
+            if (covered[e])
                 continue;
-            } else {
-                if (s.second.size() > f[m].size())
-                    m = s.first;
+            covered[e] = 1;
+            uncovered -= ix.needed[e];
+            for (size_type q = ix.at[e]; q < ix.at[e + 1]; ++q)
+                --gain[ix.sets[q]];
+        }
+        alive[i] = 0;
+        --left;
+    }
+
+    /* @fn reduce()
+     * Preprocess the instance in place. Elements that are not in _set
+     * are dropped from the family first; then, until nothing changes:
+     *   - a set that is the only cover of some element is forced: it is
+     *     removed from the family and its elements from _set;
+     *   - of several identical sets only the one with the lowest key
+     *     is kept;
+     *   - a set strictly contained in another set is removed.
+     * Any minimum cover of the reduced instance plus the forced keys
+     * is a minimum cover of the original one. Dominance ignores costs,
+     * so the reduction does not apply to weighted covers.
+     */
+    template <typename T, typename K>
+    CoverReduction<T>
+    Cover<T,K>::reduce() {
+        CoverReduction<T>    red;
+        bool                 changed = true;
+
+        red.sets_before = _family.size();
+        red.elements_before = _set.size();
+
+        for (auto it = _family.begin(); it != _family.end(); ) {
+            for (auto e = it->second.begin(); e != it->second.end(); )
+                if (_set.find(*e) == _set.end())
+                    e = it->second.erase(e);
+                else
+                    ++e;
+            if (it->second.empty())
+                it = _family.erase(it);
+            else
+                ++it;
+        }
+
+        while (changed) {
+            changed = false;
+
+            // forced sets.
+            std::map<K, std::pair<size_type, T>>    cnt;
+            for (auto &f : _family)
+                for (auto &e : f.second) {
+                    auto &c = cnt[e];
+                    ++c.first;
+                    c.second = f.first;
+                }
+            for (auto &c : cnt) {
+                if (c.second.first != 1 || _family.find(c.second.second) == _family.end())
+                    continue;
+                const T key = c.second.second;
+                std::set<K> covered = std::move(_family[key]);
+                _family.erase(key);
+                red.forced.insert(key);
+                for (auto &e : covered)
+                    _set.erase(e);
+                for (auto it = _family.begin(); it != _family.end(); ) {
+                    for (auto &e : covered)
+                        it->second.erase(e);
+                    if (it->second.empty())
+                        it = _family.erase(it);
+                    else
+                        ++it;
+                }
+                changed = true;
             }
+
+            // identical sets; _family is ordered by key, so the first
+            // set seen in each group has the lowest key.
+            std::map<std::set<K>, T>    seen;
+            for (auto it = _family.begin(); it != _family.end(); ) {
+                auto s = seen.find(it->second);
+                if (s == seen.end()) {
+                    seen.insert(std::make_pair(it->second, it->first));
+                    ++it;
+                    continue;
+                }
+                red.merged[s->second].insert(it->first);
+                // keys merged earlier into the dropped set follow it.
+                auto m = red.merged.find(it->first);
+                if (m != red.merged.end()) {
+                    red.merged[s->second].insert(m->second.begin(), m->second.end());
+                    red.merged.erase(m);
+                }
+                it = _family.erase(it);
+                changed = true;
+            }
+
+            // dominated sets, compared as bitsets over _set.
+            std::map<K, size_type>    index;
+            std::vector<T>            keys;
+            std::vector<Bitset>       sets;
+            for (auto &e : _set)
+                index.insert(std::make_pair(e, index.size()));
+            for (auto &f : _family) {
+                Bitset b(index.size());
+                for (auto &e : f.second)
+                    b.set(index[e]);
+                keys.push_back(f.first);
+                sets.push_back(std::move(b));
+            }
+            std::vector<size_type>    size(sets.size());
+            std::vector<char>         alive(sets.size(), 1);
+            for (size_type i = 0; i < sets.size(); ++i)
+                size[i] = sets[i].count();
+            for (size_type i = 0; i < sets.size(); ++i)
+                for (size_type j = 0; j < sets.size(); ++j)
+                    // identical sets are gone, so equal size means not
+                    // a strict subset.
+                    if (alive[j] && size[i] < size[j] &&
+                        sets[i].is_subset_of(sets[j])) {
+                        alive[i] = 0;
+                        _family.erase(keys[i]);
+                        ++red.dominated;
+                        changed = true;
+                        break;
+                    }
         }
+
+        red.sets_after = _family.size();
+        red.elements_after = _set.size();
+        return red;
+    }
+
+    template <typename T, typename K>
+    size_type
+    Cover<T,K>::max_set(const Residual& r) const {
+        size_type m = r.alive.size();
+
+        for (size_type i = 0; i < r.alive.size(); ++i)
+            if (r.alive[i] && (m == r.alive.size() || r.gain[i] > r.gain[m]))
+                m = i;
         return m;
     }
 
     template <typename T, typename K>
-    T
-    Cover<T,K>::max_weight_set(std::map<T, std::set<K>>& f, const size_type& size) const {
-        bool flag = false;
-        T m;
+    size_type
+    Cover<T,K>::max_weight_set(const Residual& r, const size_type& size) const {
+        size_type m = r.alive.size();
 
-        for (auto &s : f) {
-            if (!flag) {
-                flag = true;
-                m = s.first;
+        for (size_type i = 0; i < r.alive.size(); ++i) {
+            if (!r.alive[i])
                 continue;
-            } else {
-                if (s.second.size() - size == 0) {
-                    m = s.first; break;
-                } else if (std::abs(s.second.size() - size) <
-                           std::abs(f[m].size() - size)) {
-                    m = s.first;
-                }
+            if (m == r.alive.size()) {
+                m = i;
+            } else if (r.gain[i] == size) {
+                m = i; break;
+            } else if (size_distance(r.gain[i], size) <
+                       size_distance(r.gain[m], size)) {
+                m = i;
             }
         }
         return m;
@@ -185,193 +504,579 @@ namespace ndrnp {
 
     template <typename T, typename K>
     std::set<T>
-    Cover<T,K>::minimum_set_cover() const {
-        std::set<T>                mi;
-        std::set<K>                tmp_s = _set;
-        std::map<T, std::set<K>>   tmp_f = _family;
-        T                          m;
-
-        while (!tmp_s.empty()) {
-            // find a set with maximal size from remaining
-            // sets in the family.
-            m = max_set(tmp_f);
-            // delete each element in max from uncovered set.
-            for (auto &e : tmp_f[m])
-                tmp_s.erase(e);
-            // delete each covered element from remaining cover sets.
-            for (auto &f : tmp_f)
-                if (f.first != m)
-                    for (auto &e : tmp_f[m])
-                        f.second.erase(e);
-            // delete this max set from family.
-            tmp_f.erase(m);
-            // record this max set in the result.
-            mi.insert(m);
+    Cover<T,K>::greedy_cover(Residual& r, std::set<T>& mi) const {
+        while (r.uncovered != 0) {
             // if the whole family cannot guarantee a fully set cover,
             // return an empty set.
-            if (tmp_f.empty() && !tmp_s.empty()) {
+            if (r.left == 0) {
                 mi.clear();
                 return mi;
             }
+            // take a set with maximal size from the remaining sets in
+            // the family, and record it in the result.
+            size_type m = max_set(r);
+            r.take(m);
+            mi.insert(r.ix.keys[m]);
         }
         return mi;
     }
 
+    template <typename T, typename K>
+    std::set<T>
+    Cover<T,K>::minimum_set_cover() const {
+        CoverIndex<T,K>    ix;
+        std::set<T>        mi;
+
+        index(ix);
+        Residual r(ix);
+        return greedy_cover(r, mi);
+    }
+
     template <typename T, typename K>
     std::set<T>
     Cover<T,K>::weight_set_cover(const size_type& size) const {
-        std::set<T>                  mi;
-        std::set<K>                  tmp;
-        std::set<K>                  tmp_s = _set;
-        std::map<T, std::set<K>>     tmp_f = _family;
-        T                            m;
-
-        std::cout << "-------------------" << std::endl;
-        for (auto &e : tmp_s)
-            std::cout << e << " ";
-        std::cout << std::endl;
-        std::cout << "-------------------" << std::endl;
-        while (!tmp_s.empty()) {
-            m = max_weight_set(tmp_f, size);
-            for (auto &e : tmp_f[m])
-                tmp.insert(e);
-            for (auto &e : tmp_f[m])
-                tmp_s.erase(e);
-            for (auto &f : tmp_f)
-                if (f.first != m)
-                    for (auto &e : tmp_f[m])
-                        f.second.erase(e);
-            if (tmp_f[m].size() != 0) {
-                mi.insert(m);
-            }
-            tmp_f.erase(m);
-            if (tmp_f.empty() && !tmp_s.empty()) {
-                for (auto &e : tmp)
-                    std::cout << e << " ";
+        CoverIndex<T,K>    ix;
+        std::set<T>        mi;
+
+        index(ix);
+        Residual r(ix);
+        while (r.uncovered != 0) {
+            if (r.left == 0) {
                 mi.clear();
                 return mi;
             }
+            size_type m = max_weight_set(r, size);
+            // a set left empty is dropped without being chosen.
+            if (r.gain[m] != 0)
+                mi.insert(ix.keys[m]);
+            r.take(m);
         }
         return mi;
     }
     
+    /* @fn cost_set_cover()
+     * Greedy weighted set cover: repeatedly choose the set with the
+     * lowest cost per newly covered element. Since the number of
+     * uncovered elements of a set only decreases, a stale ratio in the
+     * heap is a lower bound of the true one, and a popped set is only
+     * re-evaluated (lazy greedy) instead of rescanning the family
+     * every round.
+     * @param cost cost of each set, 1.0 for keys not given.
+     * @return a cover within H(max set size) of the minimum cost, or
+     * an empty set if _set cannot be covered.
+     */
     template <typename T, typename K>
     std::set<T>
-    Cover<T,K>::rrnp_msc(const std::set<size_type>&rr) const {
-        std::set<T>                mi;
-        std::set<K>                tmp_s = _set;
-        std::map<T, std::set<K>>   tmp_f = _family;
-        T                          m;
-
-        for (auto &r : rr) {
-            for (auto &e : tmp_f[r])
-                tmp_s.erase(e);
-            for (auto &f : tmp_f)
-                if (f.first != r)
-                    for (auto &e : tmp_f[r])
-                        f.second.erase(e);
-            tmp_f.erase(r);
-            mi.insert(r);
-            if (tmp_s.empty())
-                break;
+    Cover<T,K>::cost_set_cover(const std::map<T, double>& cost) const {
+        typedef std::pair<double, size_type>    entry_type;
+
+        std::set<T>                          mi;
+        std::map<K, size_type>               index;
+        std::vector<T>                       keys;
+        std::vector<std::vector<size_type>>  sets;
+        std::vector<double>                  costs;
+        std::vector<char>                    covered;
+        size_type                            uncovered;
+        std::priority_queue<entry_type, std::vector<entry_type>,
+                            std::greater<entry_type>>    heap;
+
+        for (auto &e : _set)
+            index.insert(std::make_pair(e, index.size()));
+        for (auto &f : _family) {
+            std::vector<size_type> s;
+            for (auto &e : f.second) {
+                auto it = index.find(e);
+                if (it != index.end())
+                    s.push_back(it->second);
+            }
+            if (s.empty())
+                continue;
+            auto c = cost.find(f.first);
+            keys.push_back(f.first);
+            costs.push_back(c == cost.end() ? 1.0 : c->second);
+            heap.push(std::make_pair(costs.back() / s.size(), sets.size()));
+            sets.push_back(std::move(s));
         }
+        covered.assign(index.size(), 0);
+        uncovered = index.size();
 
-        while (!tmp_s.empty()) {
-            // find a set with maximal size from remaining
-            // sets in the family.
-            m = max_set(tmp_f);
-            // delete each element in max from uncovered set.
-            for (auto &e : tmp_f[m])
-                tmp_s.erase(e);
-            // delete each covered element from remaining cover sets.
-            for (auto &f : tmp_f)
-                if (f.first != m)
-                    for (auto &e : tmp_f[m])
-                        f.second.erase(e);
-            // delete this max set from family.
-            tmp_f.erase(m);
-            // record this max set in the result.
-            mi.insert(m);
-            // if the whole family cannot guarantee a fully set cover,
-            // return an empty set.
-            if (tmp_f.empty() && !tmp_s.empty()) {
-                mi.clear();
-                return mi;
+        while (uncovered != 0 && !heap.empty()) {
+            entry_type top = heap.top();
+            size_type  gain = 0;
+            heap.pop();
+            for (auto &e : sets[top.second])
+                if (!covered[e])
+                    ++gain;
+            if (gain == 0)
+                continue;
+            double ratio = costs[top.second] / gain;
+            // another set may now be cheaper per element, put this one
+            // back with its updated ratio.
+            if (!heap.empty() && ratio > heap.top().first) {
+                heap.push(std::make_pair(ratio, top.second));
+                continue;
+            }
+            for (auto &e : sets[top.second])
+                if (!covered[e]) {
+                    covered[e] = 1; --uncovered;
+                }
+            mi.insert(keys[top.second]);
+        }
+        if (uncovered != 0)
+            mi.clear();
+        return mi;
+    }
+
+    template <typename T, typename K>
+    bool
+    Cover<T,K>::k_demand(const size_type& k, std::vector<T>& keys,
+                         std::vector<std::vector<size_type>>& sets,
+                         std::vector<size_type>& demand) const {
+        std::map<K, size_type>    index;
+
+        for (auto &e : _set)
+            index.insert(std::make_pair(e, index.size()));
+        demand.assign(index.size(), 0);
+        for (auto &f : _family) {
+            std::vector<size_type> s;
+            for (auto &e : f.second) {
+                auto it = index.find(e);
+                if (it != index.end())
+                    s.push_back(it->second);
             }
+            if (s.empty())
+                continue;
+            for (auto &e : s)
+                if (demand[e] < k)
+                    ++demand[e];
+            keys.push_back(f.first);
+            sets.push_back(std::move(s));
+        }
+        for (auto &d : demand)
+            if (d == 0)
+                return false;
+        return true;
+    }
+
+    /* @fn k_set_cover()
+     * Greedy k-fold set cover: every element of _set is covered by k
+     * distinct chosen sets, or by all of its covering sets if it has
+     * fewer than k. Each element keeps a residual demand counter, and
+     * the gain of a set is the number of its elements with residual
+     * demand. Gains only decrease, so sets are kept in a max-heap and
+     * re-evaluated lazily when popped; a round costs O(|set| log m)
+     * instead of a scan of the family.
+     * @return the chosen keys, or an empty set if some element has
+     * no covering set at all.
+     */
+    template <typename T, typename K>
+    std::set<T>
+    Cover<T,K>::k_set_cover(const size_type& k) const {
+        typedef std::pair<size_type, size_type>    entry_type;
+
+        std::set<T>                          mi;
+        std::vector<T>                       keys;
+        std::vector<std::vector<size_type>>  sets;
+        std::vector<size_type>               demand;
+        size_type                            residual = 0;
+        std::priority_queue<entry_type>      heap;
+
+        if (!k_demand(k, keys, sets, demand))
+            return mi;
+        for (auto &d : demand)
+            residual += d;
+        // ties go to the lower index, i.e. the lower key.
+        for (size_type i = 0; i < sets.size(); ++i)
+            heap.push(std::make_pair(sets[i].size(), sets.size() - i));
+
+        while (residual != 0 && !heap.empty()) {
+            entry_type  top = heap.top();
+            size_type   i = sets.size() - top.second, gain = 0;
+            heap.pop();
+            for (auto &e : sets[i])
+                if (demand[e])
+                    ++gain;
+            if (gain == 0)
+                continue;
+            if (!heap.empty() && gain < heap.top().first) {
+                heap.push(std::make_pair(gain, top.second));
+                continue;
+            }
+            for (auto &e : sets[i])
+                if (demand[e]) {
+                    --demand[e]; --residual;
+                }
+            mi.insert(keys[i]);
         }
         return mi;
     }
 
+    /* @fn random_k_set_cover()
+     * Randomized k-fold set cover: like k_set_cover(), but each round
+     * draws a set with probability proportional to its gain (roulette
+     * wheel method).
+     */
     template <typename T, typename K>
     std::set<T>
-    Cover<T,K>::random_set_cover(std::default_random_engine& en,
-                                 const std::set<size_type>&rr) const {
-        std::set<T>                mi;
-        std::set<K>                tmp_s = _set;
-        std::map<T, std::set<K>>   tmp_f = _family;
-        T                          m;
-
-        /*for (auto &r : rr) {
-            for (auto &e : tmp_f[r])
-                tmp_s.erase(e);
-            for (auto &f : tmp_f)
-                if (f.first != r)
-                    for (auto &e : tmp_f[r])
-                        f.second.erase(e);
-            tmp_f.erase(r);
-            mi.insert(r);
-            if (tmp_s.empty())
+    Cover<T,K>::random_k_set_cover(std::default_random_engine& en,
+                                   const size_type& k) const {
+        std::set<T>                          mi;
+        std::vector<T>                       keys;
+        std::vector<std::vector<size_type>>  sets;
+        std::vector<size_type>               demand;
+        std::vector<size_type>               gain;
+        std::vector<char>                    chosen;
+        size_type                            residual = 0, total = 0;
+
+        if (!k_demand(k, keys, sets, demand))
+            return mi;
+        for (auto &d : demand)
+            residual += d;
+        chosen.assign(sets.size(), 0);
+        // covers[e] lists the sets containing element e.
+        std::vector<std::vector<size_type>>  covers(demand.size());
+        for (size_type i = 0; i < sets.size(); ++i) {
+            for (auto &e : sets[i])
+                covers[e].push_back(i);
+            gain.push_back(sets[i].size());
+            total += sets[i].size();
+        }
+
+        while (residual != 0) {
+            std::uniform_int_distribution<size_type> dis(0, total - 1);
+            size_type r = dis(en), i = 0;
+            for (; chosen[i] || r >= gain[i]; ++i)
+                if (!chosen[i])
+                    r -= gain[i];
+            chosen[i] = 1;
+            total -= gain[i];
+            mi.insert(keys[i]);
+            for (auto &e : sets[i]) {
+                if (!demand[e])
+                    continue;
+                --residual;
+                // once satisfied, the element no longer counts toward
+                // the gain of the remaining sets containing it.
+                if (--demand[e] == 0)
+                    for (auto &j : covers[e])
+                        if (!chosen[j]) {
+                            --gain[j]; --total;
+                        }
+            }
+        }
+        return mi;
+    }
+
+    /* @fn eliminate_redundant()
+     * Local search on a cover of _set. Each element keeps the number
+     * of chosen sets covering it, so a set is redundant exactly when
+     * all of its elements are counted at least twice:
+     *   - a linear sweep drops redundant sets, smallest first;
+     *   - a 2-for-1 swap adds an unchosen set C whenever it contains
+     *     the elements only covered by two or more chosen sets, which
+     *     are then dropped.
+     * Keys that are not in the family are kept as they are.
+     * @return a cover of _set no larger than given one.
+     */
+    template <typename T, typename K>
+    std::set<T>
+    Cover<T,K>::eliminate_redundant(const std::set<T>& cover) const {
+        std::set<T>                          mi;
+        std::map<K, size_type>               index;
+        std::vector<T>                       keys;
+        std::vector<std::vector<size_type>>  sets;
+        std::vector<char>                    chosen;
+        std::vector<size_type>               count, order;
+        // holders[e] lists the chosen sets containing element e.
+        std::vector<std::vector<size_type>>  holders;
+
+        for (auto &e : _set)
+            index.insert(std::make_pair(e, index.size()));
+        for (auto &f : _family) {
+            std::vector<size_type> s;
+            for (auto &e : f.second) {
+                auto it = index.find(e);
+                if (it != index.end())
+                    s.push_back(it->second);
+            }
+            keys.push_back(f.first);
+            chosen.push_back(cover.find(f.first) != cover.end());
+            sets.push_back(std::move(s));
+        }
+        for (auto &k : cover)
+            if (_family.find(k) == _family.end())
+                mi.insert(k);
+
+        count.assign(index.size(), 0);
+        holders.resize(index.size());
+        auto add = [&](const size_type& i) {
+            chosen[i] = 1;
+            for (auto &e : sets[i]) {
+                ++count[e];
+                holders[e].push_back(i);
+            }
+        };
+        auto remove = [&](const size_type& i) {
+            chosen[i] = 0;
+            for (auto &e : sets[i]) {
+                --count[e];
+                holders[e].erase(std::find(holders[e].begin(),
+                                           holders[e].end(), i));
+            }
+        };
+        auto redundant = [&](const size_type& i) {
+            for (auto &e : sets[i])
+                if (count[e] < 2)
+                    return false;
+            return true;
+        };
+
+        for (size_type i = 0; i < sets.size(); ++i)
+            if (chosen[i]) {
+                chosen[i] = 0;
+                add(i);
+                order.push_back(i);
+            }
+
+        // sweep out redundant sets, smallest first.
+        std::stable_sort(order.begin(), order.end(),
+                         [&](const size_type& a, const size_type& b) {
+                             return sets[a].size() < sets[b].size();
+                         });
+        for (auto &i : order)
+            if (redundant(i))
+                remove(i);
+
+        // 2-for-1 swaps; each one shrinks the cover, so this ends.
+        std::vector<size_type>    hits(sets.size(), 0), unique(sets.size(), 0);
+        bool                      swapped = true;
+        while (swapped) {
+            swapped = false;
+            for (size_type i = 0; i < sets.size(); ++i)
+                unique[i] = 0;
+            for (size_type e = 0; e < count.size(); ++e)
+                if (count[e] == 1)
+                    ++unique[holders[e][0]];
+            for (size_type c = 0; c < sets.size() && !swapped; ++c) {
+                if (chosen[c])
+                    continue;
+                // chosen sets whose unique elements all lie in c.
+                std::vector<size_type> owners, out;
+                for (auto &e : sets[c])
+                    if (count[e] == 1 && hits[holders[e][0]]++ == 0)
+                        owners.push_back(holders[e][0]);
+                for (auto &o : owners) {
+                    if (hits[o] == unique[o])
+                        out.push_back(o);
+                    hits[o] = 0;
+                }
+                if (out.size() < 2)
+                    continue;
+                add(c);
+                std::vector<size_type> dropped;
+                for (auto &o : out)
+                    if (redundant(o)) {
+                        remove(o);
+                        dropped.push_back(o);
+                    }
+                if (dropped.size() >= 2) {
+                    swapped = true;
+                } else {
+                    for (auto &o : dropped)
+                        add(o);
+                    remove(c);
+                }
+            }
+        }
+
+        for (size_type i = 0; i < sets.size(); ++i)
+            if (chosen[i])
+                mi.insert(keys[i]);
+        return mi;
+    }
+
+    template <typename T, typename K>
+    std::set<T>
+    Cover<T,K>::rrnp_msc(const std::set<size_type>&rr) const {
+        CoverIndex<T,K>    ix;
+        std::set<T>        mi;
+
+        index(ix);
+        Residual r(ix);
+        // take the given sets first, in order, until all is covered.
+        for (auto &k : rr) {
+            auto it = std::lower_bound(ix.keys.begin(), ix.keys.end(), T(k));
+            if (it != ix.keys.end() && *it == T(k))
+                r.take(it - ix.keys.begin());
+            mi.insert(k);
+            if (r.uncovered == 0)
                 break;
-        }*/
-
-        while (!tmp_s.empty()) {
-            // find a set with maximal size from remaining
-            // sets in the family.
-            m = random_set(en, tmp_f);
-            // delete each element in max from uncovered set.
-            for (auto &e : tmp_f[m])
-                tmp_s.erase(e);
-            // delete each covered element from remaining cover sets.
-            for (auto &f : tmp_f)
-                if (f.first != m)
-                    for (auto &e : tmp_f[m])
-                        f.second.erase(e);
-            // delete this max set from family.
-            tmp_f.erase(m);
-            // record this max set in the result.
-            mi.insert(m);
-            // if the whole family cannot guarantee a fully set cover,
-            // return an empty set.
-            if (tmp_f.empty() && !tmp_s.empty()) {
+        }
+        return greedy_cover(r, mi);
+    }
+
+    template <typename T, typename K>
+    std::set<T>
+    Cover<T,K>::random_set_cover(std::default_random_engine& en,
+                                 const std::set<size_type>&) const {
+        CoverIndex<T,K>    ix;
+
+        index(ix);
+        return random_cover(en, ix);
+    }
+
+    template <typename T, typename K>
+    std::set<T>
+    Cover<T,K>::random_cover(std::default_random_engine& en,
+                             const CoverIndex<T,K>& ix) const {
+        std::set<T>    mi;
+        Residual       r(ix);
+
+        while (r.uncovered != 0) {
+            // draw a set with probability growing with its size; if
+            // the rest of the family cannot guarantee a full set
+            // cover, return an empty set.
+            size_type m = random_set(en, r);
+            if (m == r.alive.size()) {
                 mi.clear();
                 return mi;
             }
+            r.take(m);
+            mi.insert(ix.keys[m]);
         }
         return mi;
     }
 
+    /* @fn multi_random_set_cover()
+     * Multi-start randomized set cover. Run number n draws the
+     * engine from seed_seq{seed, n}, so the set of candidate covers
+     * only depends on the master seed, not on thread scheduling.
+     * Each draw is cleaned by eliminate_redundant(). The greedy cover
+     * is the initial incumbent; ties are broken toward the lower run
+     * number.
+     * @param runs number of randomized covers to draw.
+     * @param seed master seed.
+     * @param threads number of worker threads, 0 for all cores; a
+     * single one runs on the calling thread.
+     * @param budget wall-clock budget, zero for unlimited. Runs not
+     * started before the deadline are skipped.
+     * @return the smallest cover found, or an empty set if _set
+     * cannot be covered by the family.
+     */
+    template <typename T, typename K>
+    std::set<T>
+    Cover<T,K>::multi_random_set_cover(const size_type& runs, const unsigned& seed,
+                                       const size_type& threads,
+                                       const std::chrono::milliseconds& budget) const {
+        typedef std::chrono::steady_clock  clock_type;
+
+        std::set<T>                  best = minimum_set_cover();
+        size_type                    best_run = runs;
+        std::atomic<size_type>       next(0);
+        std::mutex                   mtx;
+        const clock_type::time_point deadline = clock_type::now() + budget;
+
+        if (best.empty() || runs == 0)
+            return best;
+        // every run reads the same index.
+        CoverIndex<T,K>              ix;
+        index(ix);
+
+        auto work = [&]() {
+            size_type n;
+            while ((n = next++) < runs) {
+                if (budget != std::chrono::milliseconds::zero() &&
+                    clock_type::now() >= deadline)
+                    return;
+                std::seed_seq seq{seed, static_cast<unsigned>(n)};
+                std::default_random_engine en(seq);
+                std::set<T> c = eliminate_redundant(random_cover(en, ix));
+
+                std::lock_guard<std::mutex> lk(mtx);
+                if (!c.empty() && (c.size() < best.size() ||
+                    (c.size() == best.size() && n < best_run))) {
+                    best = std::move(c);
+                    best_run = n;
+                }
+            }
+        };
+
+        // a single worker runs on the calling thread, without a pool.
+        const size_type workers = std::min(hardware_threads(threads), runs);
+        if (workers <= 1) {
+            work();
+            return best;
+        }
+        ThreadPool                      pool(workers);
+        std::vector<std::future<void>>  done;
+
+        for (size_type t = 0; t < pool.size(); ++t)
+            done.push_back(pool.submit(work));
+        for (auto &d : done)
+            d.get();
+        return best;
+    }
+
+    /* @fn exact_set_cover()
+     * Exact minimum set cover (see ExactCover). Elements of the
+     * family that are not in _set are ignored.
+     * @param node_limit search nodes before giving up, 0 for unlimited.
+     * @param time_limit wall-clock limit, zero for unlimited.
+     * @return a minimum cover, the best cover found if a limit is
+     * reached, or an empty set if _set cannot be covered.
+     */
+    template <typename T, typename K>
+    std::set<T>
+    Cover<T,K>::exact_set_cover(const size_type& node_limit,
+                                const std::chrono::milliseconds& time_limit) const {
+        std::map<K, size_type>    index;
+        std::vector<T>            keys;
+        std::vector<Bitset>       sets;
+        std::set<T>               mi;
+
+        for (auto &e : _set)
+            index.insert(std::make_pair(e, index.size()));
+        for (auto &f : _family) {
+            Bitset b(index.size());
+            for (auto &e : f.second) {
+                auto it = index.find(e);
+                if (it != index.end())
+                    b.set(it->second);
+            }
+            if (b.none())
+                continue;
+            keys.push_back(f.first);
+            sets.push_back(std::move(b));
+        }
+
+        ExactCover ec(sets, index.size(), node_limit, time_limit);
+        for (auto &i : ec.solve())
+            mi.insert(keys[i]);
+        return mi;
+    }
 
     template <typename T, typename K>
-    T
-    Cover<T,K>::random_set(std::default_random_engine& en,
-                           std::map<T, std::set<K>>& f) const {
+    size_type
+    Cover<T,K>::random_set(std::default_random_engine& en, const Residual& r) const {
         size_type size = 0;
 
-        for (auto &s : f)
-            size += s.second.size();
+        for (size_type i = 0; i < r.alive.size(); ++i)
+            if (r.alive[i])
+                size += r.gain[i];
 
         if (size == 0)
-            throw std::range_error("empty family is given!");
+            return r.alive.size();
 
         std::uniform_int_distribution<int> dis(0, size);
-        int r = dis(en), i = 0;
+        size_type x = dis(en), j = 0;
 
-        for (auto &s : f) {
-            if (s.second.size() == 0) continue;
-            if (i <= r && r <= i + s.second.size())
-                return s.first;
-            i += s.second.size();
+        for (size_type i = 0; i < r.alive.size(); ++i) {
+            if (!r.alive[i] || r.gain[i] == 0) continue;
+            if (j <= x && x <= j + r.gain[i])
+                return i;
+            j += r.gain[i];
         }
+        return r.alive.size();
     }
 }
 #endif
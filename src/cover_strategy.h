@@ -0,0 +1,219 @@
+#ifndef NDRNP_COVER_STRATEGY_H
+#define NDRNP_COVER_STRATEGY_H
+
+#include <set>
+#include <map>
+#include <random>
+#include <chrono>
+
+#include "header.h"
+#include "cover.h"
+
+/*
+ * Cover strategies used by relay_placement() to cover one layer of
+ * nodes. A strategy is a copyable policy object providing
+ *
+ *     template <typename T, typename K>
+ *     std::set<T> operator()(Cover<T,K>&) const;
+ *         returns the chosen keys, or an empty set if the layer cannot
+ *         be covered; it may reduce the given Cover in place.
+ *     bool prune() const;
+ *         whether relays may be pruned once all layers are covered.
+ *
+ * The strategy is a template parameter of the solver, so the chosen
+ * one is resolved at compile time and inlined into the main loop.
+ */
+
+namespace ndrnp {
+    // type declarations.
+    struct GreedyStrategy;
+    struct LazyGreedyStrategy;
+    struct WeightStrategy;
+    struct CostStrategy;
+    struct RandomStrategy;
+    struct ExactStrategy;
+    struct KFoldStrategy;
+    struct WarmStrategy;
+
+    // function declarations.
+    template <typename T, typename K, typename F>
+    std::set<T> reduced_cover(Cover<T,K>&, F);
+
+    /* @fn reduced_cover()
+     * Reduce given cover (see Cover::reduce()), solve what remains
+     * with f, drop redundant sets and add the forced ones back.
+     */
+    template <typename T, typename K, typename F>
+    std::set<T>
+    reduced_cover(Cover<T,K>& cvr, F f) {
+        CoverReduction<T> red = cvr.reduce();
+        std::set<T>       mi;
+
+        if (!cvr.set().empty()) {
+            mi = f(cvr);
+            if (mi.empty())
+                return mi;
+            mi = cvr.eliminate_redundant(mi);
+        }
+        mi.insert(red.forced.begin(), red.forced.end());
+        return mi;
+    }
+
+    /* @struct GreedyStrategy
+     * Reduced greedy minimum set cover (c1np).
+     */
+    struct GreedyStrategy {
+        template <typename T, typename K>
+        std::set<T> operator()(Cover<T,K>& cvr) const {
+            return reduced_cover(cvr, [](const Cover<T,K>& c) {
+                return c.minimum_set_cover();
+            });
+        }
+        bool prune() const { return true; }
+    };
+
+    /* @struct LazyGreedyStrategy
+     * Reduced greedy minimum set cover evaluated lazily from a heap,
+     * i.e. the unit cost case of Cover::cost_set_cover().
+     */
+    struct LazyGreedyStrategy {
+        template <typename T, typename K>
+        std::set<T> operator()(Cover<T,K>& cvr) const {
+            return reduced_cover(cvr, [](const Cover<T,K>& c) {
+                return c.cost_set_cover(std::map<T, double>());
+            });
+        }
+        bool prune() const { return true; }
+    };
+
+    /* @struct WeightStrategy
+     * Greedy cover preferring sets whose size is closest to a given
+     * node degree (cwnp). The family is not reduced, since dominance
+     * does not preserve that preference.
+     */
+    struct WeightStrategy {
+        explicit WeightStrategy(const size_type& s): size(s) {}
+
+        template <typename T, typename K>
+        std::set<T> operator()(Cover<T,K>& cvr) const {
+            return cvr.weight_set_cover(size);
+        }
+        bool prune() const { return true; }
+
+        size_type    size;
+    };
+
+    /* @struct CostStrategy
+     * Minimum cost cover given a cost per candidate, e.g. the relay
+     * installation cost of each CDL; keys without a cost count 1.0.
+     */
+    struct CostStrategy {
+        explicit CostStrategy(const std::map<size_type, double>& c): cost(c) {}
+
+        std::set<size_type> operator()(Cover<size_type, size_type>& cvr) const {
+            std::set<size_type> mi = cvr.cost_set_cover(cost);
+            // with non-negative costs dropping a set never costs more.
+            return mi.empty() ? mi : cvr.eliminate_redundant(mi);
+        }
+        bool prune() const { return true; }
+
+        std::map<size_type, double>    cost;
+    };
+
+    /* @struct RandomStrategy
+     * Reduced multi-start randomized cover (see
+     * Cover::multi_random_set_cover()).
+     */
+    struct RandomStrategy {
+        RandomStrategy(const size_type& r, const unsigned& s,
+                       const size_type& t = 0,
+                       const std::chrono::milliseconds& b =
+                           std::chrono::milliseconds::zero())
+        : runs(r), seed(s), threads(t), budget(b) {}
+
+        template <typename T, typename K>
+        std::set<T> operator()(Cover<T,K>& cvr) const {
+            return reduced_cover(cvr, [this](const Cover<T,K>& c) {
+                return c.multi_random_set_cover(runs, seed, threads, budget);
+            });
+        }
+        bool prune() const { return true; }
+
+        size_type                    runs;
+        unsigned                     seed;
+        size_type                    threads;
+        std::chrono::milliseconds    budget;
+    };
+
+    /* @struct ExactStrategy
+     * Reduced branch-and-bound cover (see Cover::exact_set_cover()).
+     */
+    struct ExactStrategy {
+        explicit ExactStrategy(const size_type& n = EXACT_NODE_LIMIT,
+                               const std::chrono::milliseconds& t =
+                                   std::chrono::milliseconds::zero())
+        : node_limit(n), time_limit(t) {}
+
+        template <typename T, typename K>
+        std::set<T> operator()(Cover<T,K>& cvr) const {
+            return reduced_cover(cvr, [this](const Cover<T,K>& c) {
+                return c.exact_set_cover(node_limit, time_limit);
+            });
+        }
+        bool prune() const { return true; }
+
+        size_type                    node_limit;
+        std::chrono::milliseconds    time_limit;
+    };
+
+    /* @struct KFoldStrategy
+     * k-fold cover giving each node k candidate parents. Neither the
+     * family nor the final placement is reduced, as both would remove
+     * exactly the redundancy asked for.
+     */
+    struct KFoldStrategy {
+        explicit KFoldStrategy(const size_type& f): k(f) {}
+
+        template <typename T, typename K>
+        std::set<T> operator()(Cover<T,K>& cvr) const {
+            return cvr.k_set_cover(k);
+        }
+        bool prune() const { return k <= 1; }
+
+        size_type    k;
+    };
+
+    /* @struct WarmStrategy
+     * Greedy cover seeded with preferred keys, e.g. the relays of a
+     * previous placement (see Cover::rrnp_msc()): preferred keys of
+     * the family are taken first, the rest of the layer is covered
+     * greedily, and redundant sets are dropped. The family is not
+     * reduced, since dominance may drop preferred keys.
+     */
+    struct WarmStrategy {
+        explicit WarmStrategy(const std::set<size_type>& p): preferred(p) {}
+
+        std::set<size_type> operator()(Cover<size_type, size_type>& cvr) const {
+            const std::map<size_type, std::set<size_type>>& f = cvr.family();
+            std::set<size_type>                             rr;
+            std::set<size_type>                             covered;
+
+            for (auto &s : f) {
+                covered.insert(s.second.begin(), s.second.end());
+                if (preferred.count(s.first))
+                    rr.insert(s.first);
+            }
+            // rrnp_msc() expects the family to cover the whole set.
+            for (auto &e : cvr.set())
+                if (!covered.count(e))
+                    return std::set<size_type>();
+            std::set<size_type> mi = cvr.rrnp_msc(rr);
+            return mi.empty() ? mi : cvr.eliminate_redundant(mi);
+        }
+        bool prune() const { return true; }
+
+        std::set<size_type>    preferred;
+    };
+}
+
+#endif
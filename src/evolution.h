@@ -0,0 +1,335 @@
+#ifndef NDRNP_EVOLUTION_H
+#define NDRNP_EVOLUTION_H
+
+#include <vector>
+#include <set>
+#include <random>
+#include <unordered_map>
+#include <algorithm>   // min(), max(), sort(), find(), shuffle()
+#include <stdexcept>
+
+#include "header.h"
+#include "node.h"
+#include "prr.h"
+#include "bitset.h"
+#include "topology.h"
+#include "cover_strategy.h"
+#include "placement.h"
+#include "power.h"
+#include "thread_pool.h"
+
+/*
+ * Evolutionary relay placement: a genetic algorithm over CDL
+ * selections, seeded with the greedy (c1np) placement.
+ */
+
+namespace ndrnp {
+    // type declarations.
+    struct EvolutionConfig;
+    struct Fitness;
+    struct EvolutionResult;
+
+    // function declarations.
+    void prune_selection(const Topology&, Workspace&, Bitset&,
+                         std::default_random_engine&);
+    double average_tree_prr(const std::vector<Node*>&, const Topology&, Workspace&,
+                            const PrrModel& = PrrModel());
+    Fitness evaluate_relays(const std::vector<Node*>&, const Topology&, Workspace&,
+                            const Bitset&, const double&, const PrrModel& = PrrModel());
+    EvolutionResult evolve_placement(const std::vector<Node*>&, const Topology&,
+                                     const EvolutionConfig&,
+                                     const PrrModel& = PrrModel());
+
+    /* @struct EvolutionConfig
+     * Parameters of evolve_placement():
+     *   population - individuals per generation,
+     *   generations - generations to run,
+     *   elite      - best individuals copied unchanged to the next
+     *                generation,
+     *   mutation   - probability of flipping each CDL of a child,
+     *   prr_weight - weight of the average PRR in the fitness, see
+     *                evaluate_relays(),
+     *   threads    - threads evaluating a generation (see
+     *                hardware_threads()),
+     *   seed       - seed of the random engine; results do not depend
+     *                on the thread count.
+     */
+    struct EvolutionConfig {
+        size_type    population = 32;
+        size_type    generations = 100;
+        size_type    elite = 2;
+        double       mutation = 0.005;
+        double       prr_weight = 0.5;
+        size_type    threads = 0;
+        unsigned     seed = 0;
+    };
+
+    /* @struct Fitness
+     * Evaluation of a relay selection; the larger value the fitter.
+     */
+    struct Fitness {
+        fit_type     value;
+        size_type    relays;
+        double       prr;
+        bool         feasible;
+    };
+
+    /* @struct EvolutionResult
+     * Fittest selection found:
+     *   relays      - ids of its relays, empty if no relay is needed
+     *                 or no placement is found,
+     *   fitness     - its evaluation,
+     *   evaluations - selections evaluated,
+     *   cache_hits  - selections whose fitness was found in the cache.
+     */
+    struct EvolutionResult {
+        std::set<size_type>    relays;
+        Fitness                fitness{0.0, 0, 0.0, false};
+        size_type              evaluations = 0;
+        size_type              cache_hits = 0;
+    };
+
+    /* @fn average_tree_prr()
+     * Average end-to-end PRR of the sensors over the routing tree of
+     * the active nodes of ws (see routing_tree()), each link at the
+     * power of its sending end, as average_prr() does over an SPT.
+     * Unreachable sensors count 0.
+     */
+    double
+    average_tree_prr(const std::vector<Node*>& nds, const Topology& topo, Workspace& ws,
+                     const PrrModel& model) {
+        std::vector<size_type> parent = routing_tree(nds, topo, ws);
+        double pr = 0.0;
+
+        if (topo.sensors().empty())
+            return 0.0;
+        for (auto &d : topo.sensors()) {
+            if (parent[d] == topo.size())
+                continue;
+            double p_prr = 1.0;
+            for (size_type p = d; parent[p] != topo.size(); p = parent[p])
+                p_prr *= model.prr(nds[p]->power(), distance(*nds[p], *nds[parent[p]]));
+            pr += p_prr;
+        }
+        return pr / topo.sensors().size();
+    }
+
+    /* @fn evaluate_relays()
+     * Fitness of the relays set in mask (by position in topo): a
+     * feasible selection scores minus its relay count plus w times
+     * its average PRR (see average_tree_prr()), so for w < 1 fewer
+     * relays always win and the PRR breaks ties; an infeasible one
+     * scores below any feasible one, the lower the more sensors miss
+     * their hop constraint.
+     */
+    Fitness
+    evaluate_relays(const std::vector<Node*>& nds, const Topology& topo, Workspace& ws,
+                    const Bitset& mask, const double& w, const PrrModel& model) {
+        Fitness   f{0.0, 0, 0.0, false};
+        size_type cdls = 0;
+
+        ws.reset(topo);
+        for (size_type i = 0; i < topo.size(); ++i) {
+            if (topo.type(i) != NodeType::CDL)
+                continue;
+            ++cdls;
+            ws.active[i] = mask.test(i);
+            f.relays += mask.test(i);
+        }
+        if (hop_distances(topo, ws) == spt_status::BAD_VERTEX) {
+            f.value = -fit_type(cdls + 1 + topo.sensors().size());
+            return f;
+        }
+        size_type missed = 0;
+        for (auto &d : topo.sensors())
+            if (ws.dist[d] > topo.hop(d))
+                ++missed;
+        if (missed) {
+            f.value = -fit_type(cdls + 1 + missed);
+            return f;
+        }
+        f.feasible = true;
+        f.prr = average_tree_prr(nds, topo, ws, model);
+        f.value = -fit_type(f.relays) + w * f.prr;
+        return f;
+    }
+
+    /* @fn prune_selection()
+     * Drop the relays of a feasible selection in random order, each
+     * as long as the constraints still hold (see prune_relay()), so
+     * the selection becomes minimal; an infeasible one is left as is.
+     */
+    void
+    prune_selection(const Topology& topo, Workspace& ws, Bitset& mask,
+                    std::default_random_engine& e) {
+        std::vector<size_type> relays;
+
+        ws.reset(topo);
+        for (size_type i = 0; i < topo.size(); ++i)
+            if (topo.type(i) == NodeType::CDL) {
+                ws.active[i] = mask.test(i);
+                if (mask.test(i))
+                    relays.push_back(i);
+            }
+        if (hop_feasibility(topo, ws) != spt_status::OK)
+            return;
+        std::shuffle(relays.begin(), relays.end(), e);
+        for (auto &i : relays)
+            if (prune_relay(topo, ws, i))
+                mask.reset(i);
+    }
+
+    /* @fn evolve_placement()
+     * Relay placement by a genetic algorithm over CDL selections.
+     * The first generation is the greedy placement and mutants of it;
+     * each next one keeps the elite and breeds the rest by binary
+     * tournament, crossover (the union of both parents, which is
+     * feasible if they are) and mutation (dropping a random relay,
+     * adding a random CDL, and flipping each CDL with probability
+     * cfg.mutation). Every bred selection is then pruned to a minimal
+     * one in random order (see prune_selection()), and replaced by it.
+     * The new selections of a generation are pruned and evaluated in
+     * parallel, one workspace per worker. Results are cached by bred
+     * selection, so a selection bred again is never evaluated twice;
+     * the pruning order derives from the selection and cfg.seed, so
+     * results do not depend on the thread count.
+     * nds must be the nodes topo was built from.
+     */
+    EvolutionResult
+    evolve_placement(const std::vector<Node*>& nds, const Topology& topo,
+                     const EvolutionConfig& cfg, const PrrModel& model) {
+        typedef std::pair<Bitset, Fitness>                              entry_type;
+        typedef std::unordered_map<Bitset, entry_type, BitsetHash>      cache_type;
+
+        EvolutionResult              res;
+        std::default_random_engine   e(cfg.seed);
+        std::vector<size_type>       cdls;
+        cache_type                   cache;
+        const size_type              pop = std::max(size_type(2), cfg.population);
+
+        for (size_type i = 0; i < topo.size(); ++i)
+            if (topo.type(i) == NodeType::CDL)
+                cdls.push_back(i);
+
+        // seed with the greedy placement, or every CDL if it finds none.
+        Workspace ws;
+        Bitset    seed(topo.size());
+        std::set<size_type> y = relay_placement(topo, GreedyStrategy(), ws);
+        if (y.empty()) {
+            // no relay may be needed at all.
+            res.fitness = evaluate_relays(nds, topo, ws, seed, cfg.prr_weight, model);
+            ++res.evaluations;
+            if (res.fitness.feasible)
+                return res;
+        }
+        for (auto &c : cdls)
+            if (y.empty() || ws.active[c])
+                seed.set(c);
+        res.fitness = evaluate_relays(nds, topo, ws, seed, cfg.prr_weight, model);
+        ++res.evaluations;
+        if (!res.fitness.feasible)
+            return res;
+
+        std::uniform_real_distribution<double>     coin(0.0, 1.0);
+        std::uniform_int_distribution<size_type>   any_cdl(0, cdls.size() - 1);
+        std::vector<size_type>                     chosen;
+        auto mutate = [&](Bitset& b) {
+            chosen.clear();
+            for (auto &c : cdls)
+                if (b.test(c))
+                    chosen.push_back(c);
+            if (!chosen.empty() && coin(e) < 0.5) {
+                std::uniform_int_distribution<size_type> pick(0, chosen.size() - 1);
+                b.reset(chosen[pick(e)]);
+            }
+            if (coin(e) < 0.25)
+                b.set(cdls[any_cdl(e)]);
+            for (auto &c : cdls)
+                if (coin(e) < cfg.mutation)
+                    b.test(c) ? b.reset(c) : b.set(c);
+        };
+
+        std::vector<Bitset>  cur(1, seed), next;
+        while (cur.size() < pop) {
+            cur.push_back(seed);
+            mutate(cur.back());
+        }
+
+        std::vector<Workspace>   wss(std::max(size_type(1),
+                                     std::min(hardware_threads(cfg.threads), pop)));
+        std::vector<Fitness>     fit(pop);
+        std::vector<Bitset>      todo;
+        std::vector<entry_type>  done;
+        // prune and evaluate the selections of cur not in the cache
+        // yet, then replace every selection by its pruned one.
+        auto evaluate = [&]() {
+            todo.clear();
+            for (auto &b : cur)
+                if (cache.count(b) ||
+                    std::find(todo.begin(), todo.end(), b) != todo.end())
+                    ++res.cache_hits;
+                else
+                    todo.push_back(b);
+            done.assign(todo.size(), entry_type());
+            parallel_for(todo.size(), cfg.threads, [&](const size_type& i,
+                                                      const size_type& w) {
+                std::default_random_engine en(cfg.seed ^ todo[i].hash());
+                done[i].first = todo[i];
+                prune_selection(topo, wss[w], done[i].first, en);
+                done[i].second = evaluate_relays(nds, topo, wss[w], done[i].first,
+                                                 cfg.prr_weight, model);
+            });
+            res.evaluations += todo.size();
+            for (size_type i = 0; i < todo.size(); ++i)
+                cache.emplace(todo[i], done[i]);
+            for (size_type i = 0; i < cur.size(); ++i) {
+                const entry_type& en = cache.find(cur[i])->second;
+                cur[i] = en.first;
+                fit[i] = en.second;
+            }
+        };
+
+        std::vector<size_type> order(pop);
+        Bitset best = seed;
+        for (size_type g = 0; ; ++g) {
+            evaluate();
+            for (size_type i = 0; i < pop; ++i)
+                if (fit[i].value > res.fitness.value) {
+                    res.fitness = fit[i];
+                    best = cur[i];
+                }
+            if (g == cfg.generations)
+                break;
+
+            for (size_type i = 0; i < pop; ++i)
+                order[i] = i;
+            std::sort(order.begin(), order.end(), [&fit](const size_type& a,
+                                                         const size_type& b) {
+                return fit[a].value > fit[b].value;
+            });
+            next.clear();
+            for (size_type i = 0; i < std::min(cfg.elite, pop); ++i)
+                next.push_back(cur[order[i]]);
+
+            std::uniform_int_distribution<size_type> any(0, pop - 1);
+            auto tournament = [&]() -> const Bitset& {
+                size_type a = any(e), b = any(e);
+                return fit[a].value >= fit[b].value ? cur[a] : cur[b];
+            };
+            while (next.size() < pop) {
+                Bitset child = tournament();
+                child |= tournament();
+                mutate(child);
+                next.push_back(child);
+            }
+            cur.swap(next);
+        }
+
+        for (auto &c : cdls)
+            if (best.test(c))
+                res.relays.insert(topo.id(c));
+        return res;
+    }
+}
+
+#endif
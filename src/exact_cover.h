@@ -0,0 +1,268 @@
+#ifndef NDRNP_EXACT_COVER_H
+#define NDRNP_EXACT_COVER_H
+
+#include <vector>
+#include <chrono>
+#include <algorithm>   // sort()
+
+#include "header.h"
+#include "bitset.h"
+
+namespace ndrnp {
+    // type declarations.
+    class ExactCover;
+
+    // default number of search nodes before the exact solver gives
+    // up and returns its best incumbent.
+    const size_type EXACT_NODE_LIMIT = 1000000;
+
+    /* @class ExactCover
+     * Branch-and-bound minimum set cover over bitset sets.
+     *
+     * Before searching, the instance is reduced by repeatedly
+     * forcing sets that are the only cover of some element and
+     * removing sets dominated by another set. The greedy cover is
+     * the initial incumbent (upper bound). Each search node branches
+     * on the uncovered element having the fewest covering sets and
+     * is pruned with the larger of two lower bounds:
+     *   - counting: ceil(uncovered / largest remaining set),
+     *   - packing: a set of uncovered elements no two of which share
+     *     a covering set, each of them needs its own set (this is a
+     *     feasible solution of the dual of the LP relaxation).
+     * If the node or time limit is reached the best incumbent is
+     * returned and optimal() is false.
+     */
+    class ExactCover {
+    public:
+        typedef std::chrono::milliseconds    duration_type;
+        typedef std::chrono::steady_clock    clock_type;
+
+        ExactCover(const std::vector<Bitset>&, const size_type&,
+                   const size_type& = EXACT_NODE_LIMIT,
+                   const duration_type& = duration_type::zero());
+
+        // indices of the sets of the best cover found, or an empty
+        // vector if the universe cannot be covered.
+        std::vector<size_type> solve();
+
+        bool      feasible() const { return _feasible; }
+        bool      optimal() const { return _optimal; }
+        size_type nodes() const { return _nodes; }
+
+    private:
+        bool reduce(Bitset&);
+        void greedy(Bitset);
+        size_type bound(const Bitset&) const;
+        void search(const Bitset&);
+        bool out_of_budget();
+
+    private:
+        std::vector<Bitset>                    sets;
+        size_type                              universe;
+        // covers[e] lists the sets containing element e.
+        std::vector<std::vector<size_type>>    covers;
+        std::vector<char>                      alive;
+        std::vector<size_type>                 chosen;
+        std::vector<size_type>                 best;
+
+        size_type                              node_limit;
+        duration_type                          time_limit;
+        clock_type::time_point                 deadline;
+        size_type                              _nodes;
+        bool                                   _stop;
+        bool                                   _feasible;
+        bool                                   _optimal;
+    };
+
+    ExactCover::ExactCover(const std::vector<Bitset>& s, const size_type& n,
+                           const size_type& nl, const duration_type& tl)
+    : sets(s), universe(n), covers(n), alive(s.size(), 1),
+      node_limit(nl), time_limit(tl), _nodes(0), _stop(false),
+      _feasible(false), _optimal(false) {
+        for (size_type i = 0; i < sets.size(); ++i)
+            for (size_type e = sets[i].find_first(); e != Bitset::npos;
+                 e = sets[i].find_next(e + 1))
+                covers[e].push_back(i);
+    }
+
+    /* @fn reduce()
+     * Force every set that is the only remaining cover of an
+     * uncovered element, and drop every set whose uncovered part
+     * is contained in another set's uncovered part, until neither
+     * rule applies.
+     * @return false if some element has no covering set.
+     */
+    bool
+    ExactCover::reduce(Bitset& uncovered) {
+        bool changed = true;
+
+        while (changed) {
+            changed = false;
+            for (size_type e = uncovered.find_first(); e != Bitset::npos;
+                 e = uncovered.find_next(e + 1)) {
+                size_type cnt = 0, last = 0;
+                for (auto &s : covers[e])
+                    if (alive[s]) {
+                        ++cnt; last = s;
+                    }
+                if (cnt == 0)
+                    return false;
+                if (cnt == 1) {
+                    chosen.push_back(last);
+                    alive[last] = 0;
+                    uncovered.subtract(sets[last]);
+                    changed = true;
+                }
+            }
+            for (size_type i = 0; i < sets.size(); ++i) {
+                if (!alive[i])
+                    continue;
+                if (!sets[i].intersects(uncovered)) {
+                    alive[i] = 0; changed = true;
+                    continue;
+                }
+                for (size_type j = 0; j < sets.size(); ++j) {
+                    if (i == j || !alive[j] ||
+                        !sets[i].is_subset_of(sets[j], uncovered))
+                        continue;
+                    // of two identical sets keep the one with lower index.
+                    if (j > i && sets[j].is_subset_of(sets[i], uncovered))
+                        continue;
+                    alive[i] = 0; changed = true;
+                    break;
+                }
+            }
+        }
+        return true;
+    }
+
+    void
+    ExactCover::greedy(Bitset uncovered) {
+        best = chosen;
+        while (uncovered.any()) {
+            size_type m = 0, size = 0, c;
+            for (size_type i = 0; i < sets.size(); ++i)
+                if (alive[i] && (c = sets[i].intersect_count(uncovered)) > size) {
+                    m = i; size = c;
+                }
+            best.push_back(m);
+            uncovered.subtract(sets[m]);
+        }
+    }
+
+    size_type
+    ExactCover::bound(const Bitset& uncovered) const {
+        size_type    largest = 0, packing = 0, c, n = uncovered.count();
+        Bitset       used(sets.size());
+
+        for (size_type i = 0; i < sets.size(); ++i)
+            if (alive[i] && (c = sets[i].intersect_count(uncovered)) > largest)
+                largest = c;
+        if (largest == 0)
+            return n == 0 ? 0 : universe + 1;
+
+        for (size_type e = uncovered.find_first(); e != Bitset::npos;
+             e = uncovered.find_next(e + 1)) {
+            bool disjoint = true;
+            for (auto &s : covers[e])
+                if (alive[s] && used.test(s)) {
+                    disjoint = false; break;
+                }
+            if (!disjoint)
+                continue;
+            ++packing;
+            for (auto &s : covers[e])
+                if (alive[s])
+                    used.set(s);
+        }
+        return std::max((n + largest - 1) / largest, packing);
+    }
+
+    bool
+    ExactCover::out_of_budget() {
+        if (node_limit != 0 && _nodes > node_limit)
+            _stop = true;
+        // reading the clock on every node costs more than the node.
+        else if (time_limit != duration_type::zero() && (_nodes & 0xff) == 0 &&
+                 clock_type::now() >= deadline)
+            _stop = true;
+        return _stop;
+    }
+
+    void
+    ExactCover::search(const Bitset& uncovered) {
+        ++_nodes;
+        if (out_of_budget())
+            return;
+        if (uncovered.none()) {
+            if (chosen.size() < best.size())
+                best = chosen;
+            return;
+        }
+        if (chosen.size() + bound(uncovered) >= best.size())
+            return;
+
+        // branch on the element with the fewest covering sets.
+        size_type e = Bitset::npos, fewest = sets.size() + 1;
+        for (size_type i = uncovered.find_first(); i != Bitset::npos;
+             i = uncovered.find_next(i + 1)) {
+            size_type cnt = 0;
+            for (auto &s : covers[i])
+                if (alive[s])
+                    ++cnt;
+            if (cnt < fewest) {
+                e = i; fewest = cnt;
+            }
+        }
+        if (fewest == 0)
+            return;
+
+        std::vector<std::pair<size_type, size_type>> cand;
+        for (auto &s : covers[e])
+            if (alive[s])
+                cand.push_back(std::make_pair(sets[s].intersect_count(uncovered), s));
+        std::sort(cand.begin(), cand.end(),
+                  [](const std::pair<size_type, size_type>& a,
+                     const std::pair<size_type, size_type>& b) {
+                      return a.first > b.first ||
+                             (a.first == b.first && a.second < b.second);
+                  });
+
+        for (auto &c : cand) {
+            Bitset next = uncovered;
+            next.subtract(sets[c.second]);
+            chosen.push_back(c.second);
+            search(next);
+            chosen.pop_back();
+            // every cover containing this set has been explored, so
+            // later siblings need not consider it again.
+            alive[c.second] = 0;
+            if (_stop)
+                break;
+        }
+        for (auto &c : cand)
+            alive[c.second] = 1;
+    }
+
+    std::vector<size_type>
+    ExactCover::solve() {
+        Bitset uncovered(universe);
+
+        uncovered.set_all();
+        deadline = clock_type::now() + time_limit;
+        chosen.clear();
+        best.clear();
+        if (!reduce(uncovered)) {
+            _feasible = false;
+            _optimal = true;
+            return std::vector<size_type>();
+        }
+        _feasible = true;
+        greedy(uncovered);
+        search(uncovered);
+        _optimal = !_stop;
+        return best;
+    }
+}
+
+#endif
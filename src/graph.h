@@ -249,7 +249,10 @@ namespace ndrnp {
         AdjacencyList(): vertices(std::vector<Vertex<data_type>>()) {}
         AdjacencyList(const AdjacencyList& al): vertices(al.vertices) {}
         AdjacencyList(AdjacencyList&& al): vertices(std::move(al.vertices)) {}
-        template <class Iter> AdjacencyList(Iter, Iter);
+        template <class Iter> AdjacencyList(Iter b, Iter e)
+        : AdjacencyList(b, e, PrrModel()) {}
+        // links follow the given PRR model (see is_neighbor()).
+        template <class Iter> AdjacencyList(Iter, Iter, const PrrModel&);
         ~AdjacencyList() = default;
 
         AdjacencyList& operator=(const AdjacencyList&);
@@ -280,7 +283,7 @@ namespace ndrnp {
 
     template <class D>
     template <class Iter>
-    AdjacencyList<D>::AdjacencyList(Iter b, Iter e)
+    AdjacencyList<D>::AdjacencyList(Iter b, Iter e, const PrrModel& model)
     : vertices(std::vector<Vertex<D>>()) {
         double w;
         for (Iter iter = b; iter != e; ++iter) {
@@ -291,7 +294,7 @@ namespace ndrnp {
         for (size_type i = 0; i < vertices.size(); ++i)
             for (size_type j = 0; j < vertices.size(); ++j)
                 if (i != j && (w = is_neighbor(vertices[i].data(),
-                                          vertices[j].data())) != -1) {
+                                          vertices[j].data(), model)) != -1) {
                     vertices[i].push_neighbor(vertices[j], w);
                  }
     }
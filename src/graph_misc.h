@@ -2,12 +2,31 @@
 #define NDRNP_GRAPH_MISC_H
 
 #include <vector>
+#include <stdexcept>
 
 #include "header.h"
 #include "graph.h"
 #include "miscellaneous.h"
 
 namespace ndrnp {
+    // data type predeclarations.
+    enum class spt_status: uint8_t;
+
+    /* @enum spt_status
+     * Outcome of building a shortest path tree or checking the
+     * feasibility of a placement, i.e.:
+     * 0 - success,
+     * 1 - the source or a destination is not a vertex of the graph,
+     * 2 - some destination cannot reach the source,
+     * 3 - some destination exceeds its hop constraint.
+     */
+    enum class spt_status: uint8_t {
+        OK,
+        BAD_VERTEX,
+        DISCONNECTED,
+        HOP_VIOLATION
+    };
+
     // function predeclarations.
     template <class C>
     bool is_in(const std::vector<Vertex<C>>&, const Vertex<C>&);
@@ -181,76 +200,79 @@ namespace ndrnp {
         return false;
     }
 
+    /* @fn try_dijkstra_spt()
+     *
+     * Build a shortest path tree (in hops) from src whose leaves are
+     * the given destinations, without throwing.
+     * On success the hop distance of every vertex to src is stored in
+     * its weight field in graph (9999 if unreachable) and the tree is
+     * stored in spt; otherwise neither is touched.
+     * @return spt_status::BAD_VERTEX if src or a destination is not a
+     * vertex of graph (or a destination is src),
+     * spt_status::DISCONNECTED if some destination cannot be reached,
+     * spt_status::OK otherwise.
+     */
     template <class C>
-    AdjacencyList<C>
-    dijkstra_spt(AdjacencyList<C>& graph, size_type src,
-                 std::vector<size_type> dests) {
-        std::vector<Vertex<C>> grey, black;
-        AdjacencyList<C> al, spt;
-
-        if (src < 0 || src >= graph.size()) {
-#if !defined(NDEBUG)
-            std::cerr << "function" << __func__
-                      << "in file"  << __FILE__
-                      << "at line"  << __LINE__
-                      << ": No such vertex in this graph!"
-                      << std::endl;
-            std::exit(-1);
-#else
-;//            throw std::range_error("No such vertex in this graph!");
-#endif
-        }
+    spt_status
+    try_dijkstra_spt(AdjacencyList<C>& graph, size_type src,
+                     const std::vector<size_type>& dests,
+                     AdjacencyList<C>& spt) {
+        std::vector<Vertex<C>> grey;
+        // visiting state of each vertex: white, grey or black.
+        std::vector<char>      color(graph.size(), 0);
+        AdjacencyList<C>       al, tree;
 
+        if (src >= graph.size())
+            return spt_status::BAD_VERTEX;
         for (auto &d : dests)
-            if (d < 0 || d >= graph.size() || d == src)
-                throw std::range_error("No such vertex in this graph!");
-
-        if (!is_connected(graph, src, dests))
-            throw std::range_error("Source cannot connect all destinations.");
+            if (d >= graph.size() || d == src)
+                return spt_status::BAD_VERTEX;
 
         for (auto &v : graph) {
             al.push_back(Vertex<C>(v.data(), v.type(), v.status(), al.size()));
-            spt.push_back(Vertex<C>(v.data(), v.type(), v.status(), al.size()));
+            tree.push_back(Vertex<C>(v.data(), v.type(), v.status(), al.size()));
         }
 
         al[src].set_weight(0);
         grey.push_back(al[src]);
+        color[src] = 1;
 
         while (!grey.empty()) {
             ssize_t index;
             insertion_sort_descending(grey.begin(), grey.end());
             Vertex<C> min = grey.back();
-            black.push_back(min);
+            color[min.id()] = 2;
             grey.pop_back();
             // update shortest distance to the source node and search 
             // new grey nodes.
             for (auto &e : graph[min.id()].neighbors()) {
                 // a node having a distance greater than the minimal 
-                // grey node must be a grey or white node.
+                // grey node must be a grey or white node; with unit
+                // edge weights a black node is never updated.
                 if (al[e.end()->id()].weight() > al[min.id()].weight() + 1) {
                     al[e.end()->id()].set_weight(al[min.id()].weight() + 1);
                     al[e.end()->id()].set_parent(min.id());
                     // if this neighbor is a grey node, update its distance.
-                    if ((index = index_of(grey.begin(), grey.end(), *e.end())) >= 0) {
+                    if (color[e.end()->id()] == 1) {
+                        index = index_of(grey.begin(), grey.end(), *e.end());
                         grey[index].set_weight(al[min.id()].weight() + 1);
                     // if this neighbor is a white node, make it grey.
-                    } else if (index_of(black.begin(), black.end(), *e.end()) == -1) {
-                        grey.push_back(al[e.end()->id()]);
-                    // if this neighbor is a black node, error occurs.
                     } else {
-//                        std::cerr << "Algorithm run into wrong state." << std::endl;
-                        throw std::range_error("SPT updating black node");
+                        grey.push_back(al[e.end()->id()]);
+                        color[e.end()->id()] = 1;
                     }
                 }
             }
             // adding edge between min node and its parent.
             // source node has no parent.
-            if (min.id() != src) {
-//                 al[min.id()].push_neighbor(edge<N>(&al[min.id()], &al[min.parent()]));
+            if (size_type(min.id()) != src)
                  al[min.parent()].push_neighbor(al[min.id()]);
-            }
         }
-        
+
+        for (auto &d : dests)
+            if (color[d] != 2)
+                return spt_status::DISCONNECTED;
+
         for (size_type i = 0; i < al.size(); ++i)
             graph[i].set_weight(al[i].weight());
         // the leaves of this newly built shortest path tree may not be given
@@ -258,13 +280,44 @@ namespace ndrnp {
         // are only given destinations according to the newly built shortest
         // path tree.
         for (size_type i = 0; i < dests.size(); ++i) {
-            for (id_type j = al[dests[i]].id(); j != src; j = al[j].parent()) {
-                spt[j].set_parent(al[j].parent());
-                if (has_edge(Edge<C>(&spt[j]), 
-                             spt[spt[j].parent()].neighbors())) break;
-                spt[spt[j].parent()].push_neighbor(spt[j]);
+            for (id_type j = al[dests[i]].id(); size_type(j) != src; j = al[j].parent()) {
+                tree[j].set_parent(al[j].parent());
+                if (has_edge(Edge<C>(&tree[j]), 
+                             tree[tree[j].parent()].neighbors())) break;
+                tree[tree[j].parent()].push_neighbor(tree[j]);
             }
         }
+        spt = std::move(tree);
+        return spt_status::OK;
+    }
+
+    template <class C>
+    AdjacencyList<C>
+    dijkstra_spt(AdjacencyList<C>& graph, size_type src,
+                 std::vector<size_type> dests) {
+        AdjacencyList<C> spt;
+
+        if (src < 0 || src >= graph.size()) {
+#if !defined(NDEBUG)
+            std::cerr << "function" << __func__
+                      << "in file"  << __FILE__
+                      << "at line"  << __LINE__
+                      << ": No such vertex in this graph!"
+                      << std::endl;
+            std::exit(-1);
+#else
+;//            throw std::range_error("No such vertex in this graph!");
+#endif
+        }
+
+        switch (try_dijkstra_spt(graph, src, dests, spt)) {
+            case spt_status::BAD_VERTEX:
+                throw std::range_error("No such vertex in this graph!");
+            case spt_status::DISCONNECTED:
+                throw std::range_error("Source cannot connect all destinations.");
+            default:
+                break;
+        }
         return spt;
     }
 }
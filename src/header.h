@@ -16,14 +16,29 @@ namespace ndrnp {
     const double   TX         = 10.0;
     const hop_type HOP        = 6;
 
-    // the number of sink nodes.
-    size_type      sink_num = 1;
-    // the number of sensor nodes.
-    size_type      sensor_num = 25;
-    // the number of candidate deployment locations (cdl),
+    // default number of sink nodes.
+    const size_type sink_num = 1;
+    // default number of sensor nodes.
+    const size_type sensor_num = 25;
+    // default number of candidate deployment locations (cdl),
     // the terms relay and cdl are used interchangeable 
     // through out this program.
-    size_type      cdl_num = 400;
+    const size_type cdl_num = 400;
+
+    // type declarations.
+    struct RunConfig;
+
+    /* @struct RunConfig
+     * Node counts of one run, defaulting to the constants above, so
+     * that runs of different sizes can coexist in one process; it is
+     * passed explicitly to whatever depends on them (e.g.
+     * ExperimentPoint, restore_nodes()).
+     */
+    struct RunConfig {
+        size_type    sink_num = ndrnp::sink_num;
+        size_type    sensor_num = ndrnp::sensor_num;
+        size_type    cdl_num = ndrnp::cdl_num;
+    };
 }
 
 #endif
@@ -0,0 +1,434 @@
+#ifndef NDRNP_INCREMENTAL_H
+#define NDRNP_INCREMENTAL_H
+
+#include <vector>
+#include <set>
+#include <algorithm>   // sort(), unique(), count()
+
+#include "header.h"
+#include "node.h"
+#include "topology.h"
+#include "cover_strategy.h"
+#include "placement.h"
+
+namespace ndrnp {
+    // type declarations.
+    struct TopologyDelta;
+    class IncrementalSolver;
+
+    // resolve() covers every layer again once a delta changes more
+    // than one node in RESOLVE_LIMIT.
+    const size_type RESOLVE_LIMIT = 16;
+
+    /* @struct TopologyDelta
+     * Changes to the nodes of an IncrementalSolver since its last
+     * solve:
+     *   added   - new nodes, appended in the order given,
+     *   moved   - positions of nodes whose Node objects have been
+     *             changed in place (coordinate, power, hop, ...),
+     *   removed - positions of nodes taken out of the network; they
+     *             keep their position but are never linked again.
+     */
+    struct TopologyDelta {
+        std::vector<Node*>        added;
+        std::vector<size_type>    moved;
+        std::vector<size_type>    removed;
+    };
+
+    /* @class IncrementalSolver
+     * Relay placement kept up to date while sensors come, go and
+     * move. resolve() relinks only the changed nodes (O(n) each
+     * instead of rebuilding the whole topology), updates the hop
+     * distances of the nodes the new links change, and, layer by
+     * layer, keeps the relays covering the nodes whose candidate
+     * relays have not changed, covering only the rest again. Those
+     * are covered preferring the relays already deployed (see
+     * WarmStrategy), so the new placement mostly keeps them.
+     * The Node objects are not owned and must outlive the solver.
+     */
+    class IncrementalSolver {
+    public:
+        explicit IncrementalSolver(const std::vector<Node*>& nds,
+                                   const PrrModel& model = PrrModel())
+        : nodes(nds), model(model), topo(nds, model), ok(false) {}
+        IncrementalSolver(const IncrementalSolver&) = delete;
+        IncrementalSolver& operator=(const IncrementalSolver&) = delete;
+
+        // solve from scratch with the given strategy.
+        template <class Strategy>
+        std::set<size_type> solve(const Strategy&);
+        std::set<size_type> solve() { return solve(GreedyStrategy()); }
+        // apply delta and solve again, warm started from the current
+        // placement.
+        std::set<size_type> resolve(const TopologyDelta&);
+
+        // ids of the relays of the current placement.
+        std::set<size_type> placement() const;
+        // whether the current placement meets the constraints.
+        bool feasible() const { return ok; }
+        const Topology& topology() const { return topo; }
+
+    private:
+        // flags of touched: the links into a node, or its distance
+        // from the sink, changed with the last delta.
+        static const char LINKS_CHANGED = 1;
+        static const char DIST_CHANGED = 2;
+
+        // a layer as last covered: its nodes, their hop budgets then,
+        // and the nodes chosen to cover it.
+        struct Layer {
+            std::vector<size_type>    nodes;
+            std::vector<hop_type>     hops;
+            std::set<size_type>       chosen;
+        };
+
+        void update_distances(const std::vector<size_type>&);
+        template <class Strategy>
+        std::set<size_type> repair(const Layer&, const Strategy&);
+        template <class Strategy>
+        bool cover(const Strategy&);
+        void settle(const bool&);
+
+    private:
+        std::vector<Node*>     nodes;
+        PrrModel               model;
+        Topology               topo;
+        Workspace              ws;
+        // hop distance of each node from the sink over all nodes, and
+        // what the last delta changed of each node (see LINKS_CHANGED
+        // and DIST_CHANGED).
+        std::vector<hop_type>  dist;
+        std::vector<char>      touched;
+        std::vector<Layer>     layers;
+        // positions of the current relays.
+        std::set<size_type>    relays;
+        bool                   ok;
+    };
+
+    template <class Strategy>
+    std::set<size_type>
+    IncrementalSolver::solve(const Strategy& strategy) {
+        ws.reset(topo);
+        hop_distances(topo, ws);
+        dist = ws.dist;
+        layers.clear();
+        bool placed = cover(strategy);
+        if (placed && strategy.prune())
+            for (size_type i = 0; i < topo.size(); ++i)
+                if (ws.selected[i])
+                    prune_relay(topo, ws, i);
+        settle(placed);
+        return placement();
+    }
+
+    /* @fn IncrementalSolver::cover()
+     * As cover_layers() with the distances in dist, except that a
+     * layer covered the last time too is only repaired (see
+     * repair()). The layers covered are recorded for the next time.
+     */
+    template <class Strategy>
+    bool
+    IncrementalSolver::cover(const Strategy& strategy) {
+        std::vector<Layer> prev;
+
+        prev.swap(layers);
+        if (topo.sink() >= topo.size())
+            return false;
+        ws.reset(topo);
+        for (size_type i = 0; i < topo.size(); ++i)
+            ws.active[i] = topo.type(i) != NodeType::CDL;
+        if (hop_feasibility(topo, ws) == spt_status::OK)
+            return false;
+        ws.active.assign(topo.size(), 1);
+        ws.dist = dist;
+        for (auto &d : topo.sensors())
+            if (dist[d] > topo.hop(d))
+                return false;
+
+        hop_type DELTA = first_layer(topo, ws);
+        for (size_type k = 0; !ws.ik.empty(); ++k) {
+            if (k > size_type(DELTA)) {
+                layers.clear();
+                return false;
+            }
+            layer_family(topo, ws);
+            Layer l;
+            l.nodes = ws.ik;
+            for (auto &u : ws.ik)
+                l.hops.push_back(ws.hop[u]);
+            if (k < prev.size()) {
+                l.chosen = repair(prev[k], strategy);
+            } else {
+                ws.cover.assign(ws.fam.begin(), ws.fam.end(), ws.ik.begin(), ws.ik.end());
+                l.chosen = strategy(ws.cover);
+            }
+            if (l.chosen.empty()) {
+                layers.clear();
+                return false;
+            }
+            next_layer(topo, l.chosen, ws);
+            layers.push_back(std::move(l));
+        }
+
+        for (size_type i = 0; i < topo.size(); ++i)
+            if (topo.type(i) == NodeType::CDL && !ws.selected[i])
+                ws.active[i] = 0;
+        return true;
+    }
+
+    /* @fn IncrementalSolver::resolve()
+     * A delta changing more than one node in RESOLVE_LIMIT relinks
+     * the whole topology at once instead; such a delta, or one moving
+     * the sink, covers every layer again from fresh distances.
+     * If some layer cannot be covered, no relay is placed and
+     * feasible() is false (see cover_layers()).
+     */
+    std::set<size_type>
+    IncrementalSolver::resolve(const TopologyDelta& delta) {
+        const size_type src = topo.sink();
+        const size_type n = delta.removed.size() + delta.moved.size() + delta.added.size();
+        const bool large = n * RESOLVE_LIMIT > topo.size();
+        // the nodes whose incoming links change: the changed nodes
+        // and their out-neighbors before and after.
+        std::vector<size_type> changed;
+
+        if (large) {
+            std::vector<size_type> gone(delta.removed);
+            for (size_type i = 0; i < topo.size(); ++i)
+                if (topo.removed(i))
+                    gone.push_back(i);
+            nodes.insert(nodes.end(), delta.added.begin(), delta.added.end());
+            topo.assign(nodes, model);
+            topo.remove(gone);
+        } else {
+            for (auto &i : delta.removed) {
+                changed.push_back(i);
+                changed.insert(changed.end(), topo.out(i).begin(), topo.out(i).end());
+                topo.remove(i);
+            }
+            for (auto &i : delta.moved) {
+                changed.push_back(i);
+                changed.insert(changed.end(), topo.out(i).begin(), topo.out(i).end());
+                topo.update(nodes, i);
+                changed.insert(changed.end(), topo.out(i).begin(), topo.out(i).end());
+            }
+            for (auto &nd : delta.added) {
+                size_type i = nodes.size();
+                nodes.push_back(nd);
+                topo.update(nodes, i);
+                changed.push_back(i);
+                changed.insert(changed.end(), topo.out(i).begin(), topo.out(i).end());
+            }
+            std::sort(changed.begin(), changed.end());
+            changed.erase(std::unique(changed.begin(), changed.end()), changed.end());
+        }
+
+        std::set<size_type> deployed;
+        for (auto &i : relays)
+            if (!topo.removed(i))
+                deployed.insert(i);
+        bool cold = large || layers.empty() || topo.sink() != src || src >= topo.size() ||
+                    std::count(delta.moved.begin(), delta.moved.end(), src);
+        if (cold) {
+            ws.reset(topo);
+            hop_distances(topo, ws);
+            dist = ws.dist;
+            layers.clear();
+        } else {
+            update_distances(changed);
+        }
+
+        bool placed = cover(WarmStrategy(deployed));
+        if (placed)
+            for (size_type i = 0; i < topo.size(); ++i)
+                if (ws.selected[i])
+                    prune_relay(topo, ws, i);
+        settle(placed);
+        return placement();
+    }
+
+    /* @fn IncrementalSolver::update_distances()
+     * Bring dist up to date once the links into the given nodes have
+     * changed, without a search from the sink: the nodes left with no
+     * neighbor one hop closer to the sink lose their distance, as do
+     * in turn the nodes they were that neighbor for; these get their
+     * distance back from their remaining neighbors, and every node
+     * whose distance drops passes it on, breadth first. touched marks
+     * the changed nodes LINKS_CHANGED and those whose distance changed
+     * DIST_CHANGED.
+     */
+    void
+    IncrementalSolver::update_distances(const std::vector<size_type>& changed) {
+        const size_type src = topo.sink();
+        std::vector<hop_type>  before;
+        std::vector<char>      lost(topo.size(), 0);
+        std::vector<size_type> queue(changed);
+        std::vector<size_type> gone;
+
+        dist.resize(topo.size(), 9999);
+        before = dist;
+        for (size_type head = 0; head < queue.size(); ++head) {
+            size_type u = queue[head];
+            if (u == src || lost[u] || dist[u] == 9999)
+                continue;
+            bool held = false;
+            for (auto &v : topo.in(u))
+                if (!lost[v] && dist[v] + 1 == dist[u]) {
+                    held = true;
+                    break;
+                }
+            if (held)
+                continue;
+            lost[u] = 1;
+            gone.push_back(u);
+            for (auto &w : topo.out(u))
+                if (dist[w] == dist[u] + 1)
+                    queue.push_back(w);
+        }
+        for (auto &u : gone)
+            dist[u] = 9999;
+
+        queue.clear();
+        auto closer = [this, &queue](const size_type& u) {
+            for (auto &v : topo.in(u))
+                if (dist[v] != 9999 && dist[v] + 1 < dist[u])
+                    dist[u] = dist[v] + 1;
+            if (dist[u] != 9999)
+                queue.push_back(u);
+        };
+        for (auto &u : gone)
+            closer(u);
+        for (auto &u : changed)
+            if (u != src)
+                closer(u);
+        for (size_type head = 0; head < queue.size(); ++head) {
+            size_type v = queue[head];
+            for (auto &u : topo.out(v))
+                if (dist[u] > dist[v] + 1) {
+                    dist[u] = dist[v] + 1;
+                    queue.push_back(u);
+                }
+        }
+
+        touched.assign(topo.size(), 0);
+        for (auto &u : changed)
+            touched[u] = LINKS_CHANGED;
+        for (size_type i = 0; i < topo.size(); ++i)
+            if (dist[i] != before[i])
+                touched[i] |= DIST_CHANGED;
+    }
+
+    /* @fn IncrementalSolver::repair()
+     * Cover the layer in ws.ik, last covered as l. A node of both
+     * with the same budget, the same incoming links and no incoming
+     * neighbor at another distance has the candidate relays it had
+     * then, so the nodes of l.chosen covering such a node are kept;
+     * the nodes they leave uncovered are covered with the strategy,
+     * and the kept nodes this makes redundant are dropped.
+     * @return the nodes chosen, or an empty set if the layer cannot
+     * be covered.
+     */
+    template <class Strategy>
+    std::set<size_type>
+    IncrementalSolver::repair(const Layer& l, const Strategy& strategy) {
+        std::vector<char>      same(topo.size(), 0);
+        std::vector<size_type> covered(topo.size(), 0);
+        std::vector<size_type> rest;
+        std::vector<std::pair<size_type, size_type>>    part;
+        std::set<size_type>    mi;
+
+        // both layers are sorted, as made by first_layer() and
+        // next_layer().
+        for (size_type j = 0, p = 0; j < ws.ik.size(); ++j) {
+            size_type u = ws.ik[j];
+            while (p < l.nodes.size() && l.nodes[p] < u)
+                ++p;
+            if (p == l.nodes.size() || l.nodes[p] != u ||
+                l.hops[p] != ws.hop[u] || (touched[u] & LINKS_CHANGED))
+                continue;
+            same[u] = 1;
+            for (auto &v : topo.in(u))
+                if (touched[v] & DIST_CHANGED) {
+                    same[u] = 0;
+                    break;
+                }
+        }
+        for (auto &c : l.chosen) {
+            auto first = std::lower_bound(ws.fam.begin(), ws.fam.end(),
+                                          std::make_pair(c, size_type(0)));
+            auto last = first;
+            bool keep = false;
+            for (; last != ws.fam.end() && last->first == c; ++last)
+                keep = keep || same[last->second];
+            if (!keep)
+                continue;
+            mi.insert(c);
+            for (; first != last; ++first)
+                covered[first->second] = 1;
+        }
+
+        for (auto &u : ws.ik)
+            if (!covered[u])
+                rest.push_back(u);
+        if (!rest.empty()) {
+            for (auto &p : ws.fam)
+                if (!covered[p.second])
+                    part.push_back(p);
+            ws.cover.assign(part.begin(), part.end(), rest.begin(), rest.end());
+            std::set<size_type> tmp = strategy(ws.cover);
+            if (tmp.empty())
+                return tmp;
+            mi.insert(tmp.begin(), tmp.end());
+        }
+
+        // a kept node may now only cover nodes covered by others too.
+        std::fill(covered.begin(), covered.end(), 0);
+        for (auto &p : ws.fam)
+            if (mi.count(p.first))
+                ++covered[p.second];
+        for (auto &c : l.chosen) {
+            if (!mi.count(c))
+                continue;
+            auto first = std::lower_bound(ws.fam.begin(), ws.fam.end(),
+                                          std::make_pair(c, size_type(0)));
+            auto last = first;
+            bool needed = false;
+            for (; !needed && last != ws.fam.end() && last->first == c; ++last)
+                needed = covered[last->second] == 1;
+            if (needed)
+                continue;
+            mi.erase(c);
+            for (; first != last; ++first)
+                --covered[first->second];
+        }
+        return mi;
+    }
+
+    /* @fn IncrementalSolver::settle()
+     * Take the active CDLs of ws as the current relays if relays
+     * were placed, none otherwise, and check them against the
+     * constraints.
+     */
+    void
+    IncrementalSolver::settle(const bool& placed) {
+        relays.clear();
+        for (size_type i = 0; placed && i < topo.size(); ++i)
+            if (topo.type(i) == NodeType::CDL && ws.active[i] && !topo.removed(i))
+                relays.insert(i);
+        for (size_type i = 0; i < topo.size(); ++i)
+            ws.active[i] = topo.type(i) != NodeType::CDL || relays.count(i);
+        ok = hop_feasibility(topo, ws) == spt_status::OK;
+        if (!ok)
+            relays.clear();
+    }
+
+    std::set<size_type>
+    IncrementalSolver::placement() const {
+        std::set<size_type> res;
+        for (auto &i : relays)
+            res.insert(topo.id(i));
+        return res;
+    }
+}
+
+#endif
@@ -0,0 +1,419 @@
+#ifndef NDRNP_MONTE_CARLO_H
+#define NDRNP_MONTE_CARLO_H
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <set>
+#include <random>
+#include <chrono>
+#include <functional>
+#include <algorithm>   // sort()
+#include <cmath>       // sqrt(), floor()
+#include <stdexcept>
+#include <utility>     // pair
+
+#include "header.h"
+#include "node.h"
+#include "graph.h"
+#include "graph_misc.h"
+#include "rrnp_misc.h"
+#include "prr.h"
+#include "topology.h"
+#include "placement.h"
+#include "thread_pool.h"
+
+/*
+ * Monte Carlo evaluation of relay placement: many random topologies
+ * are generated for a parameter point, every solver is run on each
+ * of them and the metrics of the resulting networks are summarized.
+ */
+
+namespace ndrnp {
+    // type declarations.
+    struct ExperimentPoint;
+    struct TrialInstance;
+    struct Solver;
+    struct TrialResult;
+    struct Summary;
+    struct PointSummary;
+
+    // function declarations.
+    void random_topology(const ExperimentPoint&, std::default_random_engine&, Nodes&);
+    bool same_instances(const ExperimentPoint&, const ExperimentPoint&);
+    Summary summarize(std::vector<double>);
+    template <class Strategy>
+    Solver make_solver(const std::string&, const Strategy&);
+    TrialResult measure(const TrialInstance&, const std::set<size_type>&,
+                        const ExperimentPoint&);
+    std::vector<PointSummary> monte_carlo(const std::vector<ExperimentPoint>&,
+                                          const std::vector<Solver>&,
+                                          const size_type& = 0);
+    std::vector<PointSummary> monte_carlo(const ExperimentPoint&,
+                                          const std::vector<Solver>&,
+                                          const size_type& = 0);
+    void write_summary_header(std::ostream&);
+    void write_summary(std::ostream&, const PointSummary&);
+
+    /* @struct ExperimentPoint
+     * One parameter point: the shape of the random topologies and
+     * the number of trials. Trial t of a point uses an engine seeded
+     * with {seed, t}, so results do not depend on the thread count.
+     */
+    struct ExperimentPoint {
+        // numbers of sinks, sensors and CDLs.
+        RunConfig          counts;
+        // side of the square field, in m.
+        coordinate_type    field = 100.0;
+        // transmit power of every node (absolute value, in dBm).
+        Node::power_type   power = TX;
+        // sensor hop constraints are drawn from [hop_min, hop_max].
+        hop_type           hop_min = 10;
+        hop_type           hop_max = 20;
+        // delay over each link, for the average delay.
+        hop_type           link_delay = LINK_DELAY;
+        // transmit power level passed to average_energy(): 0, 1 or 2.
+        int                power_level = 0;
+        PrrModel           model;
+        size_type          trials = 100;
+        unsigned           seed = 0;
+    };
+
+    /* @struct TrialInstance
+     * The random topology of trial t of a point, both as nodes and
+     * as a Topology, shared read-only by every solver run on it.
+     */
+    struct TrialInstance {
+        TrialInstance(const ExperimentPoint&, const size_type&);
+
+        Nodes       nodes;
+        Topology    topo;
+    };
+
+    TrialInstance::TrialInstance(const ExperimentPoint& pt, const size_type& t) {
+        std::seed_seq              seq{pt.seed, static_cast<unsigned>(t)};
+        std::default_random_engine e(seq);
+
+        random_topology(pt, e, nodes);
+        topo.assign(nodes, pt.model);
+    }
+
+    /* @struct Solver
+     * A named relay placement solver, solving the given topology with
+     * the given workspace (see relay_placement()).
+     */
+    struct Solver {
+        typedef std::function<std::set<size_type>(const Topology&,
+                                                  Workspace&)>    solve_type;
+
+        std::string    name;
+        solve_type     solve;
+    };
+
+    /* @struct TrialResult
+     * Metrics of one solver on one topology; the averages are only
+     * meaningful if feasible is true.
+     */
+    struct TrialResult {
+        bool         feasible = false;
+        size_type    relays = 0;
+        double       hop = 0.0;
+        double       prr = 0.0;
+        double       delay = 0.0;
+        double       energy = 0.0;
+        double       seconds = 0.0;
+    };
+
+    /* @struct Summary
+     * Statistics of a sample. ci is the half width of the 95%
+     * confidence interval of the mean (normal approximation).
+     */
+    struct Summary {
+        size_type    n = 0;
+        double       mean = 0.0;
+        double       stddev = 0.0;
+        double       ci = 0.0;
+        double       min = 0.0;
+        double       p05 = 0.0;
+        double       p50 = 0.0;
+        double       p95 = 0.0;
+        double       max = 0.0;
+    };
+
+    /* @struct PointSummary
+     * Summary of one solver over the feasible trials of a point.
+     */
+    struct PointSummary {
+        ExperimentPoint    point;
+        std::string        solver;
+        size_type          feasible = 0;
+        Summary            relays;
+        Summary            hop;
+        Summary            prr;
+        Summary            delay;
+        Summary            energy;
+        Summary            seconds;
+    };
+
+    /* @fn random_topology()
+     * Generate the sinks, then the sensors, then the CDLs of the
+     * given point, uniformly in the field, into nds.
+     */
+    void
+    random_topology(const ExperimentPoint& pt, std::default_random_engine& e,
+                    Nodes& nds) {
+        std::uniform_real_distribution<coordinate_type> d(0.0, pt.field);
+        std::uniform_int_distribution<hop_type> h(pt.hop_min, pt.hop_max);
+        id_type id = 0;
+
+        // the nodes of the previous trial free their pool slots for
+        // these ones.
+        nds.clear();
+        nds.reserve(pt.counts.sink_num + pt.counts.sensor_num + pt.counts.cdl_num);
+        coordinate_type x, y;
+        for (size_type i = 0; i < pt.counts.sink_num; ++i) {
+            x = d(e); y = d(e);
+            nds.emplace_back<Sink>(Coordinate(x, y, 0.0), pt.power, 9999, id++);
+        }
+        for (size_type i = 0; i < pt.counts.sensor_num; ++i) {
+            x = d(e); y = d(e);
+            nds.emplace_back<Sensor>(Coordinate(x, y, 0.0), pt.power, h(e), id++);
+        }
+        for (size_type i = 0; i < pt.counts.cdl_num; ++i) {
+            x = d(e); y = d(e);
+            nds.emplace_back<CDL>(Coordinate(x, y, 0.0), pt.power, 9999, id++);
+        }
+    }
+
+    /* @fn same_instances()
+     * Whether two points generate the same topologies, i.e. differ
+     * at most in the link delay and the power level, which only
+     * enter the metrics.
+     */
+    bool
+    same_instances(const ExperimentPoint& a, const ExperimentPoint& b) {
+        const PrrModel& m = a.model;
+        const PrrModel& n = b.model;
+
+        return a.counts.sink_num == b.counts.sink_num &&
+               a.counts.sensor_num == b.counts.sensor_num &&
+               a.counts.cdl_num == b.counts.cdl_num &&
+               a.field == b.field && a.power == b.power &&
+               a.hop_min == b.hop_min && a.hop_max == b.hop_max &&
+               a.trials == b.trials && a.seed == b.seed &&
+               m.bits == n.bits && m.ple == n.ple && m.dr == n.dr &&
+               m.nb == n.nb && m.sigma == n.sigma && m.pl0 == n.pl0 &&
+               m.nf == n.nf && m.d0 == n.d0;
+    }
+
+    /* @fn summarize()
+     * Mean, standard deviation, confidence interval and percentiles
+     * (linearly interpolated) of the given sample.
+     */
+    Summary
+    summarize(std::vector<double> xs) {
+        Summary s;
+
+        s.n = xs.size();
+        if (xs.empty())
+            return s;
+        std::sort(xs.begin(), xs.end());
+        for (auto &x : xs)
+            s.mean += x;
+        s.mean /= xs.size();
+        if (xs.size() > 1) {
+            for (auto &x : xs)
+                s.stddev += (x - s.mean) * (x - s.mean);
+            s.stddev = std::sqrt(s.stddev / (xs.size() - 1));
+            s.ci = 1.96 * s.stddev / std::sqrt(static_cast<double>(xs.size()));
+        }
+        auto percentile = [&xs](const double& q) {
+            double    r = q * (xs.size() - 1);
+            size_type i = static_cast<size_type>(std::floor(r));
+            if (i + 1 >= xs.size())
+                return xs.back();
+            return xs[i] + (r - i) * (xs[i + 1] - xs[i]);
+        };
+        s.min = xs.front();
+        s.p05 = percentile(0.05);
+        s.p50 = percentile(0.50);
+        s.p95 = percentile(0.95);
+        s.max = xs.back();
+        return s;
+    }
+
+    /* @fn make_solver()
+     * Solver running relay placement with the given cover strategy.
+     */
+    template <class Strategy>
+    Solver
+    make_solver(const std::string& name, const Strategy& strategy) {
+        return Solver{name, [strategy](const Topology& topo, Workspace& ws) {
+            return relay_placement(topo, strategy, ws);
+        }};
+    }
+
+    /* @fn measure()
+     * Metrics of the network made of the sink, the sensors and the
+     * relays y of inst. The network is feasible if every sensor
+     * reaches the sink (the first node) within its hop constraint.
+     */
+    TrialResult
+    measure(const TrialInstance& inst, const std::set<size_type>& y,
+            const ExperimentPoint& pt) {
+        TrialResult              r;
+        std::vector<Node*>       net;
+        std::vector<size_type>   dests;
+        AdjacencyList<Node*>     spt;
+
+        // unselected CDLs are left out rather than powered off, so
+        // the shared nodes are never modified.
+        for (auto &n : inst.nodes) {
+            if (n->type() == NodeType::CDL && y.count(n->id()) == 0)
+                continue;
+            if (n->type() == NodeType::SENSOR)
+                dests.push_back(net.size());
+            net.push_back(n);
+        }
+        AdjacencyList<Node*> al(net.begin(), net.end(), pt.model);
+        if (try_dijkstra_spt(al, 0, dests, spt) != spt_status::OK ||
+            !meet_hop(al, 0, dests))
+            return r;
+        r.feasible = true;
+        r.relays = y.size();
+        r.hop = average_hop(spt, dests);
+        r.prr = average_prr(spt, dests, pt.model);
+        r.delay = r.hop * pt.link_delay;
+        r.energy = average_energy(spt, dests, pt.power_level);
+        return r;
+    }
+
+    /* @fn monte_carlo()
+     * Run every solver on pt.trials random topologies of each given
+     * point, and summarize each solver over its feasible trials.
+     * Every (point, trial) pair is scheduled on the given number of
+     * threads. A trial's topology is generated once and shared by
+     * all solvers, and by all points generating the same topologies
+     * (see same_instances()).
+     * @return one summary per point and solver, point by point.
+     * @throw std::range_error if a point has a power level other
+     * than 0, 1 or 2 (see check_power_level()).
+     */
+    std::vector<PointSummary>
+    monte_carlo(const std::vector<ExperimentPoint>& pts,
+                const std::vector<Solver>& solvers, const size_type& threads) {
+        // points sharing their topologies, and the (group, trial) tasks.
+        std::vector<std::vector<size_type>>          groups;
+        std::vector<std::pair<size_type, size_type>> tasks;
+        // res[p][s][t] is the result of solver s on trial t of point p.
+        std::vector<std::vector<std::vector<TrialResult>>>  res(pts.size());
+
+        // a bad level would only show up inside the workers.
+        for (auto &pt : pts)
+            check_power_level(pt.power_level);
+        for (size_type p = 0; p < pts.size(); ++p) {
+            size_type g = 0;
+            while (g < groups.size() && !same_instances(pts[groups[g][0]], pts[p]))
+                ++g;
+            if (g == groups.size())
+                groups.push_back(std::vector<size_type>());
+            groups[g].push_back(p);
+            res[p].assign(solvers.size(), std::vector<TrialResult>(pts[p].trials));
+        }
+        for (size_type g = 0; g < groups.size(); ++g)
+            for (size_type t = 0; t < pts[groups[g][0]].trials; ++t)
+                tasks.push_back(std::make_pair(g, t));
+
+        // parallel_for() runs min(threads, tasks) workers.
+        std::vector<Workspace> ws(std::max(size_type(1),
+                                  std::min(hardware_threads(threads), tasks.size())));
+        parallel_for(tasks.size(), threads, [&](const size_type& i,
+                                                const size_type& w) {
+            const std::vector<size_type>& group = groups[tasks[i].first];
+            const size_type               t = tasks[i].second;
+            TrialInstance                 inst(pts[group[0]], t);
+
+            for (size_type s = 0; s < solvers.size(); ++s) {
+                auto start = std::chrono::steady_clock::now();
+                std::set<size_type> y = solvers[s].solve(inst.topo, ws[w]);
+                double seconds = std::chrono::duration<double>(
+                                     std::chrono::steady_clock::now() - start).count();
+                // no placement found leaves y empty, and the network of
+                // the sensors alone infeasible.
+                for (auto &p : group) {
+                    res[p][s][t] = measure(inst, y, pts[p]);
+                    res[p][s][t].seconds = seconds;
+                }
+            }
+        });
+
+        std::vector<PointSummary> sums;
+        for (size_type p = 0; p < pts.size(); ++p)
+            for (size_type s = 0; s < solvers.size(); ++s) {
+                std::vector<double> relays, hop, prr, delay, energy, seconds;
+                PointSummary        ps;
+                for (auto &r : res[p][s])
+                    if (r.feasible) {
+                        relays.push_back(r.relays);
+                        hop.push_back(r.hop);
+                        prr.push_back(r.prr);
+                        delay.push_back(r.delay);
+                        energy.push_back(r.energy);
+                        seconds.push_back(r.seconds);
+                    }
+                ps.point = pts[p];
+                ps.solver = solvers[s].name;
+                ps.feasible = relays.size();
+                ps.relays = summarize(relays);
+                ps.hop = summarize(hop);
+                ps.prr = summarize(prr);
+                ps.delay = summarize(delay);
+                ps.energy = summarize(energy);
+                ps.seconds = summarize(seconds);
+                sums.push_back(ps);
+            }
+        return sums;
+    }
+
+    std::vector<PointSummary>
+    monte_carlo(const ExperimentPoint& pt, const std::vector<Solver>& solvers,
+                const size_type& threads) {
+        return monte_carlo(std::vector<ExperimentPoint>(1, pt), solvers, threads);
+    }
+
+    /* @fn write_summary_header()
+     * Column names of the rows written by write_summary().
+     */
+    void
+    write_summary_header(std::ostream& os) {
+        os << "solver,sensors,cdls,field,power,hop_min,hop_max,link_delay,"
+              "power_level,bits,ple,dr,nb,std,pl0,nf,d0,trials,feasible";
+        for (auto &m : {"relays", "hop", "prr", "delay", "energy", "seconds"})
+            os << "," << m << "_mean," << m << "_ci," << m << "_p05,"
+               << m << "_p50," << m << "_p95";
+        os << std::endl;
+    }
+
+    /* @fn write_summary()
+     * Write one comma separated row per solver and parameter point.
+     */
+    void
+    write_summary(std::ostream& os, const PointSummary& ps) {
+        const ExperimentPoint& pt = ps.point;
+        const PrrModel&        m = pt.model;
+
+        os << ps.solver << "," << pt.counts.sensor_num << "," << pt.counts.cdl_num << ","
+           << pt.field << "," << pt.power << "," << pt.hop_min << ","
+           << pt.hop_max << "," << pt.link_delay << "," << pt.power_level << ","
+           << m.bits << "," << m.ple << "," << m.dr << "," << m.nb << ","
+           << m.sigma << "," << m.pl0 << "," << m.nf << "," << m.d0 << ","
+           << pt.trials << "," << ps.feasible;
+        for (auto x : {&ps.relays, &ps.hop, &ps.prr, &ps.delay, &ps.energy,
+                       &ps.seconds})
+            os << "," << x->mean << "," << x->ci << "," << x->p05 << ","
+               << x->p50 << "," << x->p95;
+        os << std::endl;
+    }
+}
+
+#endif
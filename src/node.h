@@ -7,6 +7,9 @@
 #include <vector>
 #include <cmath>       // isnan
 #include <cstdint>     // uintx_t
+#include <memory>      // unique_ptr
+#include <new>         // placement new
+#include <type_traits> // aligned_union
 
 #include "header.h"
 #include "coordinate.h"
@@ -18,6 +21,7 @@ namespace ndrnp {
     class Sensor;
     class CDL;
     class Sink;
+    class NodePool;
     class Nodes;
     enum class NodeType: uint8_t;
     enum class CDLStatus: uint8_t;
@@ -149,11 +153,65 @@ namespace ndrnp {
         NodeType type() const override { return NodeType::SINK; }
     };
 
+    /* @class NodePool
+     * Storage for Sensor, CDL and Sink objects, handed out slot by
+     * slot from slabs of SLAB slots. Slots are never given back one
+     * by one: reset() makes every slot free again at once, keeping
+     * the slabs for the next nodes, and the slabs are freed with the
+     * pool. Objects must be constructed and destroyed by the caller.
+     */
+    class NodePool {
+    public:
+        typedef std::aligned_union<0, Sensor, CDL, Sink>::type  slot_type;
+
+        static const size_type SLAB = 1024;
+
+        NodePool() = default;
+        NodePool(NodePool&& o) noexcept: slabs(std::move(o.slabs)), used(o.used) {
+            o.used = 0;
+        }
+
+        // a free slot, allocating a new slab if needed.
+        void* allocate();
+        // make every slot free again.
+        void reset() { used = 0; }
+        // free every slab.
+        void release() { slabs.clear(); used = 0; }
+        // ensure n slots in all without allocating further.
+        void reserve(const size_type&);
+
+    private:
+        std::vector<std::unique_ptr<slot_type[]>>    slabs;
+        // slots handed out since the last reset().
+        size_type                                    used = 0;
+    };
+
+    void*
+    NodePool::allocate() {
+        if (used == slabs.size() * SLAB)
+            slabs.emplace_back(new slot_type[SLAB]);
+        void* p = &slabs[used / SLAB][used % SLAB];
+        ++used;
+        return p;
+    }
+
+    void
+    NodePool::reserve(const size_type& n) {
+        while (slabs.size() * SLAB < n)
+            slabs.emplace_back(new slot_type[SLAB]);
+    }
+
     /* @class Nodes
      * A set of wireless nodes.
      * The main purpose of this class is to ensure the 
      * allocated memory will be safely released in case
      * of accident.
+     * Nodes are either given as pointers from new, deleted one by one,
+     * or constructed in place by emplace_back() in a pool of slabs,
+     * released all at once by clear() and reused by the next nodes;
+     * the latter avoids a heap allocation per node when instances are
+     * built and dropped over and over. Both kinds may be mixed.
+     * A const Nodes converts to the std::vector<Node*> solvers take.
      */
     class Nodes {
     public:
@@ -163,8 +221,12 @@ namespace ndrnp {
         typedef std::vector<Node*>::const_iterator const_iterator;
 
         Nodes(): nodes(std::vector<Node*>()) {}
+        Nodes(const Nodes&) = delete;
+        Nodes(Nodes&&) = default;
         ~Nodes() { clear(); }
 
+        Nodes& operator=(const Nodes&) = delete;
+
         iterator begin() noexcept { return nodes.begin(); }
         const_iterator begin() const noexcept { return nodes.begin(); }
         iterator end() noexcept { return nodes.end(); }
@@ -174,17 +236,67 @@ namespace ndrnp {
         bool empty() const { return nodes.empty(); }
         value_type& operator[](size_type n) { return nodes[n]; }
         const value_type& operator[](size_type n) const { return nodes[n]; }
-
-        void push_back(const value_type& val) { nodes.push_back(val); }
-        void push_back(value_type&& val) { nodes.push_back(std::move(val)); }
-        void pop_back() { delete nodes[nodes.size() - 1]; nodes.pop_back(); }
-        void clear() { while (!empty()) pop_back(); }
+        operator const std::vector<Node*>&() const noexcept { return nodes; }
+
+        void push_back(const value_type& val) { nodes.push_back(val); pooled.push_back(0); }
+        void push_back(value_type&& val) { nodes.push_back(std::move(val)); pooled.push_back(0); }
+        // construct a T (Sensor, CDL or Sink) from args in the pool.
+        template <class T, class... Args>
+        T* emplace_back(Args&&...);
+        void pop_back();
+        // drop every node, freeing the pool slots at once.
+        void clear();
+        // room for n nodes, pool slots included.
+        void reserve(const size_type& n) { nodes.reserve(n); pooled.reserve(n); pool.reserve(n); }
+        // clear() and also free the memory of the pool.
+        void release() { clear(); pool.release(); }
 
         Node* back() { return nodes.back(); }
     private:
         std::vector<Node*> nodes;
+        // whether each node lives in the pool.
+        std::vector<char>  pooled;
+        NodePool           pool;
     };
 
+    template <class T, class... Args>
+    T*
+    Nodes::emplace_back(Args&&... args) {
+        static_assert(sizeof(T) <= sizeof(NodePool::slot_type) &&
+                      alignof(T) <= alignof(NodePool::slot_type),
+                      "Node type does not fit a pool slot");
+        // make room first, so that no constructed node can be lost.
+        nodes.reserve(nodes.size() + 1);
+        pooled.reserve(pooled.size() + 1);
+        T* p = new (pool.allocate()) T(std::forward<Args>(args)...);
+        nodes.push_back(p);
+        pooled.push_back(1);
+        return p;
+    }
+
+    void
+    Nodes::pop_back() {
+        // a pool slot is only freed by clear().
+        if (pooled.back())
+            nodes.back()->~Node();
+        else
+            delete nodes.back();
+        nodes.pop_back();
+        pooled.pop_back();
+    }
+
+    void
+    Nodes::clear() {
+        for (size_type i = 0; i < nodes.size(); ++i)
+            if (pooled[i])
+                nodes[i]->~Node();
+            else
+                delete nodes[i];
+        nodes.clear();
+        pooled.clear();
+        pool.reset();
+    }
+
 // function definitions.
     /* @fn distance
      * Euclidean distance between two nodes.
@@ -199,18 +311,24 @@ namespace ndrnp {
      * nodes can communicate with each other directly. If so,
      * a positive number representing link quality is returned, 
      * otherwise, a negative -1.0 is returned to indicate failure.
+     * Link quality follows the given PRR model, or the default one.
      */
     double
-    is_neighbor(const Node* n1, const Node* n2) {
+    is_neighbor(const Node* n1, const Node* n2, const PrrModel& model) {
         double p;
         if (n1->power() <= 0.0 || n2->power() <= 0.0)
             return -1.0;
-        p = prr(n1->power(), distance(*n1, *n2));
+        p = model.prr(n1->power(), distance(*n1, *n2));
         if (std::isnan(p) || p < PRR_CONSTRAINT)
             return -1.0;
         return p;
     }
 
+    double
+    is_neighbor(const Node* n1, const Node* n2) {
+        return is_neighbor(n1, n2, PrrModel());
+    }
+
     std::ostream&
     operator<<(std::ostream& os, const Node& n) {
         os << "[" << (n.type() == NodeType::SENSOR ? "sensor" :
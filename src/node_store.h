@@ -0,0 +1,194 @@
+#ifndef NDRNP_NODE_STORE_H
+#define NDRNP_NODE_STORE_H
+
+#include <vector>
+#include <cmath>       // sqrt(), isnan()
+#include <stdexcept>
+#include <cstddef>     // size_t
+
+#include "header.h"
+#include "coordinate.h"
+#include "prr.h"
+#include "node.h"
+
+namespace ndrnp {
+    // type declarations.
+    class NodeStore;
+
+    // function declarations.
+    template <std::size_t N = 3>
+    Coordinate::coordinate_type squared_distance(const NodeStore&, const size_type&,
+                                                 const size_type&);
+    Coordinate::coordinate_type distance(const NodeStore&, const size_type&,
+                                         const size_type&);
+    double is_neighbor(const NodeStore&, const size_type&, const size_type&,
+                       const PrrModel& = PrrModel());
+
+    /* @class NodeStore
+     * Nodes stored field by field in contiguous arrays (x, y, z,
+     * power, hop, type, status, id), so that kernels running over
+     * every pair of nodes read dense memory and make no virtual call.
+     * Nodes are referred to by position, as in a Topology; index()
+     * gives the position of a node from its id. A store whose nodes
+     * all have z = 0 is planar(), so that kernels may skip z.
+     */
+    class NodeStore {
+    public:
+        typedef Node::coordinate_type    coordinate_type;
+        typedef Node::power_type         power_type;
+
+        NodeStore() = default;
+        explicit NodeStore(const std::vector<Node*>& nds) { assign(nds); }
+
+        // refill from nds, keeping the capacity of every array.
+        void assign(const std::vector<Node*>&);
+        // append a node, returning its position.
+        // @throw std::range_error if its id is negative or taken.
+        size_type push_back(const Coordinate&, const NodeType&, const power_type&,
+                            const hop_type&, const id_type&,
+                            const CDLStatus& = CDLStatus::UNSELECTED);
+        void clear();
+
+        size_type size() const { return _type.size(); }
+        // whether every node has z = 0.
+        bool planar() const { return _off_plane == 0; }
+        // position of the node with the given id, size() if none.
+        size_type index(const id_type& id) const {
+            return id < 0 || size_type(id) >= _index.size() ? size() : _index[id];
+        }
+
+        coordinate_type x(const size_type& i) const { return _x[i]; }
+        coordinate_type y(const size_type& i) const { return _y[i]; }
+        coordinate_type z(const size_type& i) const { return _z[i]; }
+        Coordinate coordinate(const size_type& i) const {
+            return Coordinate(_x[i], _y[i], _z[i]);
+        }
+        power_type power(const size_type& i) const { return _power[i]; }
+        hop_type   hop(const size_type& i) const { return _hop[i]; }
+        NodeType   type(const size_type& i) const { return _type[i]; }
+        CDLStatus  status(const size_type& i) const { return _status[i]; }
+        id_type    id(const size_type& i) const { return _id[i]; }
+
+        void set_coordinate(const size_type& i, const Coordinate& co) {
+            _off_plane += (co.z() != 0.0) - (_z[i] != 0.0);
+            _x[i] = co.x(); _y[i] = co.y(); _z[i] = co.z();
+        }
+        void set_power(const size_type& i, const power_type& p) { _power[i] = p; }
+        void set_hop(const size_type& i, const hop_type& h) { _hop[i] = h; }
+        void set_status(const size_type& i, const CDLStatus& s) { _status[i] = s; }
+
+        // copy the powers and hop constraints back to the nodes the
+        // store was filled from, e.g. once a solver has changed them.
+        void write_back(const std::vector<Node*>&) const;
+
+    private:
+        std::vector<coordinate_type>    _x;
+        std::vector<coordinate_type>    _y;
+        std::vector<coordinate_type>    _z;
+        std::vector<power_type>         _power;
+        std::vector<hop_type>           _hop;
+        std::vector<NodeType>           _type;
+        std::vector<CDLStatus>          _status;
+        std::vector<id_type>            _id;
+        // position of each id, size() for unused ids.
+        std::vector<size_type>          _index;
+        // nodes with z != 0.
+        size_type                       _off_plane = 0;
+    };
+
+    void
+    NodeStore::clear() {
+        _x.clear();
+        _y.clear();
+        _z.clear();
+        _power.clear();
+        _hop.clear();
+        _type.clear();
+        _status.clear();
+        _id.clear();
+        _index.clear();
+        _off_plane = 0;
+    }
+
+    size_type
+    NodeStore::push_back(const Coordinate& co, const NodeType& t, const power_type& p,
+                         const hop_type& h, const id_type& id, const CDLStatus& s) {
+        if (id < 0 || (size_type(id) < _index.size() && _index[id] < size()))
+            throw std::range_error("Bad or duplicate node id");
+        // unused ids map past the end.
+        if (size_type(id) >= _index.size())
+            _index.resize(id + 1, static_cast<size_type>(-1));
+        _index[id] = size();
+        _x.push_back(co.x());
+        _y.push_back(co.y());
+        _z.push_back(co.z());
+        _off_plane += co.z() != 0.0;
+        _power.push_back(p);
+        _hop.push_back(h);
+        _type.push_back(t);
+        _status.push_back(s);
+        _id.push_back(id);
+        return size() - 1;
+    }
+
+    void
+    NodeStore::assign(const std::vector<Node*>& nds) {
+        clear();
+        for (auto &n : nds) {
+            // only a CDL has a status; the type is read once per node.
+            NodeType t = n->type();
+            push_back(n->coordinate(), t, n->power(), n->hop(), n->id(),
+                      t == NodeType::CDL && n->isSelected() ?
+                          CDLStatus::SELECTED : CDLStatus::UNSELECTED);
+        }
+    }
+
+    void
+    NodeStore::write_back(const std::vector<Node*>& nds) const {
+        for (size_type i = 0; i < size() && i < nds.size(); ++i) {
+            nds[i]->set_power(_power[i]);
+            nds[i]->set_hop(_hop[i]);
+        }
+    }
+
+    /* @fn squared_distance()
+     * Squared Euclidean distance between the nodes at positions i and
+     * j, over the first N coordinates: N = 2 leaves z out, which is
+     * exact for a planar() store.
+     */
+    template <std::size_t N>
+    Coordinate::coordinate_type
+    squared_distance(const NodeStore& st, const size_type& i, const size_type& j) {
+        static_assert(N == 2 || N == 3, "Only 2-D and 3-D distances are supported");
+        Coordinate::coordinate_type x = st.x(i) - st.x(j);
+        Coordinate::coordinate_type y = st.y(i) - st.y(j);
+        Coordinate::coordinate_type z = N == 3 ? st.z(i) - st.z(j) : 0.0;
+        return N == 3 ? x * x + y * y + z * z : x * x + y * y;
+    }
+
+    /* @fn distance()
+     * Euclidean distance between the nodes at positions i and j.
+     */
+    Coordinate::coordinate_type
+    distance(const NodeStore& st, const size_type& i, const size_type& j) {
+        return std::sqrt(squared_distance<3>(st, i, j));
+    }
+
+    /* @fn is_neighbor()
+     * As is_neighbor() over nodes, for the nodes at positions i and
+     * j of a store.
+     */
+    double
+    is_neighbor(const NodeStore& st, const size_type& i, const size_type& j,
+                const PrrModel& model) {
+        double p;
+        if (st.power(i) <= 0.0 || st.power(j) <= 0.0)
+            return -1.0;
+        p = model.prr(st.power(i), distance(st, i, j));
+        if (std::isnan(p) || p < PRR_CONSTRAINT)
+            return -1.0;
+        return p;
+    }
+}
+
+#endif
@@ -0,0 +1,308 @@
+#ifndef NDRNP_PARETO_H
+#define NDRNP_PARETO_H
+
+#include <vector>
+#include <set>
+#include <map>
+#include <string>
+#include <random>
+#include <functional>
+#include <algorithm>   // shuffle(), remove_if(), min(), max()
+#include <iterator>    // next()
+#include <stdexcept>
+
+#include "header.h"
+#include "node.h"
+#include "prr.h"
+#include "topology.h"
+#include "cover_strategy.h"
+#include "placement.h"
+#include "power.h"
+#include "rrnp_misc.h" // forwarding_energy()
+#include "thread_pool.h"
+
+/*
+ * Multi-objective relay placement: many candidate placements are
+ * generated and the non-dominated ones over relay count, delay,
+ * reliability (PRR) and energy are kept, so that a planner can pick
+ * a trade-off without solving again per weighting.
+ */
+
+namespace ndrnp {
+    // type declarations.
+    struct ParetoPoint;
+    class ParetoArchive;
+    struct ParetoConfig;
+
+    // function declarations.
+    template <class Strategy>
+    std::function<bool(Workspace&)> covering_run(const Topology&, const Strategy&);
+    bool dominates(const ParetoPoint&, const ParetoPoint&);
+    ParetoPoint placement_objectives(const std::vector<Node*>&, const Topology&,
+                                     Workspace&, const hop_type& = LINK_DELAY,
+                                     const int& = 0, const PrrModel& = PrrModel());
+    std::vector<ParetoPoint> pareto_placements(const std::vector<Node*>&,
+                                               const Topology&, const ParetoConfig&,
+                                               const PrrModel& = PrrModel());
+
+    /* @struct ParetoPoint
+     * A placement and its objectives: the number of relays, the
+     * average delay and energy (all to minimize) and the average PRR
+     * (to maximize) of the sensors; source names the candidate that
+     * produced it.
+     */
+    struct ParetoPoint {
+        std::set<size_type>    relays;
+        size_type              count = 0;
+        double                 delay = 0.0;
+        double                 prr = 0.0;
+        double                 energy = 0.0;
+        std::string            source;
+    };
+
+    /* @fn dominates()
+     * Whether a is no worse than b in every objective and better in
+     * at least one.
+     */
+    bool
+    dominates(const ParetoPoint& a, const ParetoPoint& b) {
+        if (a.count > b.count || a.delay > b.delay || a.prr < b.prr ||
+            a.energy > b.energy)
+            return false;
+        return a.count < b.count || a.delay < b.delay || a.prr > b.prr ||
+               a.energy < b.energy;
+    }
+
+    /* @class ParetoArchive
+     * Non-dominated points, bucketed by relay count: a point may only
+     * be dominated by points of the buckets up to its count and only
+     * dominate points of the buckets from its count on, so an insert
+     * scans each bucket once and only those it can affect. Among
+     * points with equal objectives the first inserted is kept.
+     */
+    class ParetoArchive {
+    public:
+        // add p unless some point dominates or equals it, dropping the
+        // points it dominates.
+        // @return true if p is added.
+        bool insert(const ParetoPoint&);
+
+        size_type size() const;
+        // every point, by relay count.
+        std::vector<ParetoPoint> points() const;
+
+    private:
+        std::map<size_type, std::vector<ParetoPoint>>    buckets;
+    };
+
+    bool
+    ParetoArchive::insert(const ParetoPoint& p) {
+        for (auto it = buckets.begin(); it != buckets.end() && it->first <= p.count; ++it)
+            for (auto &q : it->second)
+                if (dominates(q, p) || (q.count == p.count && q.delay == p.delay &&
+                                        q.prr == p.prr && q.energy == p.energy))
+                    return false;
+        for (auto it = buckets.lower_bound(p.count); it != buckets.end(); ) {
+            std::vector<ParetoPoint>& b = it->second;
+            b.erase(std::remove_if(b.begin(), b.end(), [&p](const ParetoPoint& q) {
+                        return dominates(p, q);
+                    }), b.end());
+            it = b.empty() ? buckets.erase(it) : std::next(it);
+        }
+        buckets[p.count].push_back(p);
+        return true;
+    }
+
+    size_type
+    ParetoArchive::size() const {
+        size_type n = 0;
+        for (auto &b : buckets)
+            n += b.second.size();
+        return n;
+    }
+
+    std::vector<ParetoPoint>
+    ParetoArchive::points() const {
+        std::vector<ParetoPoint> res;
+        for (auto &b : buckets)
+            res.insert(res.end(), b.second.begin(), b.second.end());
+        return res;
+    }
+
+    /* @struct ParetoConfig
+     * Candidates of pareto_placements(), besides the greedy, lazy
+     * greedy and unpruned greedy covers:
+     *   degrees       - node degrees tried by the weighted cover,
+     *   max_fold      - k-fold covers for k = 2 .. max_fold,
+     *   random_covers - randomized covers,
+     *   prune_orders  - random pruning orders of the greedy cover;
+     * and the settings of the objectives (see placement_objectives())
+     * and of the run:
+     *   link_delay, power_level, threads, seed.
+     */
+    struct ParetoConfig {
+        std::vector<size_type>    degrees = {2, 3, 4, 5, 6};
+        size_type                 max_fold = 3;
+        size_type                 random_covers = 16;
+        size_type                 prune_orders = 16;
+        hop_type                  link_delay = LINK_DELAY;
+        int                       power_level = 0;
+        size_type                 threads = 0;
+        unsigned                  seed = 0;
+    };
+
+    /* @fn placement_objectives()
+     * Objectives of the placement given by the active nodes of ws,
+     * over its routing tree (see routing_tree()): the average hop
+     * count of the sensors times link_delay, their average
+     * end-to-end PRR (see average_tree_prr()) and the average energy
+     * at the given power level (see forwarding_energy()). The relays
+     * are not filled in.
+     * @throw std::range_error for a power level other than 0, 1 or 2.
+     */
+    ParetoPoint
+    placement_objectives(const std::vector<Node*>& nds, const Topology& topo,
+                         Workspace& ws, const hop_type& link_delay,
+                         const int& power_level, const PrrModel& model) {
+        std::vector<size_type>  parent = routing_tree(nds, topo, ws);
+        std::set<size_type>     num;
+        ParetoPoint             pt;
+        double                  hop = 0.0, tx = 0.0;
+
+        check_power_level(power_level);
+
+        for (size_type i = 0; i < topo.size(); ++i)
+            if (topo.type(i) == NodeType::CDL && ws.active[i])
+                ++pt.count;
+        if (topo.sensors().empty())
+            return pt;
+        for (auto &d : topo.sensors()) {
+            double p_prr = 1.0;
+            hop += ws.dist[d];
+            for (size_type p = d; parent[p] != topo.size(); p = parent[p]) {
+                p_prr *= model.prr(nds[p]->power(), distance(*nds[p], *nds[parent[p]]));
+                if (parent[p] != topo.sink()) {
+                    ++tx;
+                    num.insert(p);
+                }
+            }
+            pt.prr += p_prr;
+        }
+        pt.delay = hop / topo.sensors().size() * link_delay;
+        pt.prr /= topo.sensors().size();
+        pt.energy = forwarding_energy(tx, num.size(), power_level);
+        return pt;
+    }
+
+    /* @fn covering_run()
+     * Run of the layered cover of topo with the given strategy,
+     * pruned in ascending order if the strategy allows it, as
+     * relay_placement() does; false if no placement is found.
+     */
+    template <class Strategy>
+    std::function<bool(Workspace&)>
+    covering_run(const Topology& topo, const Strategy& strategy) {
+        return [&topo, strategy](Workspace& ws) {
+            if (!cover_layers(topo, strategy, ws))
+                return false;
+            if (strategy.prune())
+                for (size_type i = 0; i < topo.size(); ++i)
+                    if (ws.selected[i])
+                        prune_relay(topo, ws, i);
+            return true;
+        };
+    }
+
+    /* @fn pareto_placements()
+     * Pareto set of the candidate placements of cfg over topo: the
+     * greedy, lazy greedy and weighted covers, pruned; the greedy
+     * cover unpruned and pruned in random orders; k-fold covers; and
+     * randomized covers. Candidates run in parallel, one workspace
+     * per worker, and enter the archive in a fixed order, so the
+     * result does not depend on the thread count.
+     * nds must be the nodes topo was built from.
+     * @return the non-dominated placements by relay count, a single
+     * empty one if no relay is needed, none if no placement is found.
+     * @throw std::range_error for a power level other than 0, 1 or 2.
+     */
+    std::vector<ParetoPoint>
+    pareto_placements(const std::vector<Node*>& nds, const Topology& topo,
+                      const ParetoConfig& cfg, const PrrModel& model) {
+        typedef std::function<bool(Workspace&)>    run_type;
+
+        std::vector<std::pair<std::string, run_type>>  cands;
+
+        // a bad level would only show up inside the workers.
+        check_power_level(cfg.power_level);
+        cands.push_back(std::make_pair("greedy", covering_run(topo, GreedyStrategy())));
+        cands.push_back(std::make_pair("lazy", covering_run(topo, LazyGreedyStrategy())));
+        for (auto &d : cfg.degrees)
+            cands.push_back(std::make_pair("weight:" + std::to_string(d),
+                                           covering_run(topo, WeightStrategy(d))));
+        cands.push_back(std::make_pair("greedy unpruned", run_type([&topo](Workspace& ws) {
+            return cover_layers(topo, GreedyStrategy(), ws);
+        })));
+        for (size_type k = 2; k <= cfg.max_fold; ++k)
+            cands.push_back(std::make_pair("kfold:" + std::to_string(k),
+                                           covering_run(topo, KFoldStrategy(k))));
+        for (size_type i = 0; i < cfg.random_covers; ++i)
+            cands.push_back(std::make_pair("random#" + std::to_string(i),
+                                           covering_run(topo,
+                                               RandomStrategy(1, cfg.seed + i, 1))));
+        for (size_type i = 0; i < cfg.prune_orders; ++i)
+            cands.push_back(std::make_pair("greedy order#" + std::to_string(i),
+                                           run_type([&topo, &cfg, i](Workspace& ws) {
+                std::vector<size_type>      order;
+                std::default_random_engine  e(cfg.seed + i);
+                if (!cover_layers(topo, GreedyStrategy(), ws))
+                    return false;
+                for (size_type j = 0; j < topo.size(); ++j)
+                    if (ws.selected[j])
+                        order.push_back(j);
+                std::shuffle(order.begin(), order.end(), e);
+                for (auto &j : order)
+                    prune_relay(topo, ws, j);
+                return true;
+            })));
+
+        // no relay may be needed at all.
+        Workspace ws;
+        ws.reset(topo);
+        for (size_type i = 0; i < topo.size(); ++i)
+            ws.active[i] = topo.type(i) != NodeType::CDL;
+        if (hop_feasibility(topo, ws) == spt_status::OK) {
+            ParetoPoint pt = placement_objectives(nds, topo, ws, cfg.link_delay,
+                                                  cfg.power_level, model);
+            pt.source = "none";
+            return std::vector<ParetoPoint>(1, pt);
+        }
+
+        std::vector<ParetoPoint>  pts(cands.size());
+        std::vector<char>         found(cands.size(), 0);
+        std::vector<Workspace>    wss(std::max(size_type(1),
+                                      std::min(hardware_threads(cfg.threads), cands.size())));
+        parallel_for(cands.size(), cfg.threads, [&](const size_type& i,
+                                                   const size_type& w) {
+            Workspace& wk = wss[w];
+            if (!cands[i].second(wk))
+                return;
+            // k-fold covers may keep unneeded relays, but every
+            // candidate must be feasible.
+            if (hop_feasibility(topo, wk) != spt_status::OK)
+                return;
+            pts[i] = placement_objectives(nds, topo, wk, cfg.link_delay,
+                                          cfg.power_level, model);
+            pts[i].relays = placed_relays(topo, wk);
+            pts[i].source = cands[i].first;
+            found[i] = 1;
+        });
+
+        ParetoArchive archive;
+        for (size_type i = 0; i < cands.size(); ++i)
+            if (found[i])
+                archive.insert(pts[i]);
+        return archive.points();
+    }
+}
+
+#endif
@@ -0,0 +1,240 @@
+#ifndef NDRNP_PARTITION_H
+#define NDRNP_PARTITION_H
+
+#include <vector>
+#include <set>
+#include <algorithm>   // sort(), min(), max()
+#include <cmath>       // atan2(), remainder(), fabs()
+#include <stdexcept>
+
+#include "header.h"
+#include "node.h"
+#include "topology.h"
+#include "placement.h"
+#include "thread_pool.h"
+
+/*
+ * Spatially partitioned relay placement for fields too large for one
+ * solve: the sensors are split into angular sectors around the sink,
+ * each sector is solved on its own (in parallel) over the CDLs near
+ * it, and the placements are stitched into one.
+ */
+
+namespace ndrnp {
+    // type declarations.
+    struct PartitionConfig;
+    struct PartitionResult;
+
+    // function declarations.
+    template <class Strategy>
+    PartitionResult partitioned_placement(const std::vector<Node*>&, const Strategy&,
+                                          const PartitionConfig&,
+                                          const PrrModel& = PrrModel());
+
+    /* @struct PartitionConfig
+     * Shape of the tiles of partitioned_placement():
+     *   tiles   - number of sectors, each holding about as many
+     *             sensors,
+     *   overlap - angular margin (in radians) by which the CDLs of a
+     *             tile extend beyond its sensors on both sides,
+     *   core    - radius around the sink whose CDLs belong to every
+     *             tile, since angles mean little close to it,
+     *   threads - threads solving tiles (see hardware_threads()).
+     */
+    struct PartitionConfig {
+        size_type          tiles = 8;
+        double             overlap = 0.3;
+        coordinate_type    core = 0.0;
+        size_type          threads = 0;
+    };
+
+    /* @struct PartitionResult
+     * Stitched placement and how it came about:
+     *   relays      - ids of the relays, empty if no relay is needed
+     *                 or no placement is found,
+     *   tiles       - tiles solved, the combined fallback tile
+     *                 included,
+     *   merged      - failed tiles solved again together as that
+     *                 combined tile, 0 if there is none,
+     *   tile_relays - relays placed by the tiles before stitching,
+     *   retries     - tile solves repeated with a wider overlap,
+     *   feasible    - whether every sensor meets its hop constraint.
+     */
+    struct PartitionResult {
+        std::set<size_type>    relays;
+        size_type              tiles = 0;
+        size_type              merged = 0;
+        size_type              tile_relays = 0;
+        size_type              retries = 0;
+        bool                   feasible = false;
+    };
+
+    /* @fn partitioned_placement()
+     * Relay placement over nds split into cfg.tiles sectors around
+     * the (single) sink. Each tile is solved over the sink, its own
+     * sensors and the CDLs within its sector widened by cfg.overlap,
+     * so every tile keeps the full hop budget of its sensors to the
+     * sink. A tile whose sensors cannot be served that way is solved
+     * again with twice the overlap; the tiles still failing once the
+     * overlap spans the whole field are solved together as one.
+     * Tiles are sectors reaching the edge of the field, but the graph
+     * of each is linked over a grid of range-sized cells (see
+     * Topology::link()), so its cost grows with the nodes of the tile
+     * rather than their square.
+     * The union of the tile placements is feasible for the whole
+     * network (more relays never lengthen a path); the repair pass
+     * then prunes the relays made redundant by overlapping tiles over
+     * the network of the sink, the sensors and those relays only.
+     * Nothing of nds is modified.
+     * @throw std::range_error if no sink or several sinks are given.
+     */
+    template <class Strategy>
+    PartitionResult
+    partitioned_placement(const std::vector<Node*>& nds, const Strategy& strategy,
+                          const PartitionConfig& cfg, const PrrModel& model) {
+        PartitionResult         res;
+        size_type               src = nds.size();
+        std::vector<size_type>  sensors, cdls;
+
+        for (size_type i = 0; i < nds.size(); ++i) {
+            if (nds[i]->type() == NodeType::SINK) {
+                if (src != nds.size())
+                    throw std::range_error("Multiple sinks are given");
+                src = i;
+            } else if (nds[i]->type() == NodeType::SENSOR)
+                sensors.push_back(i);
+            else
+                cdls.push_back(i);
+        }
+        if (src == nds.size())
+            throw std::range_error("No sink is given");
+        if (sensors.empty()) {
+            res.feasible = true;
+            return res;
+        }
+
+        const Coordinate sc = nds[src]->coordinate();
+        std::vector<double> angle(nds.size(), 0.0);
+        for (size_type i = 0; i < nds.size(); ++i)
+            angle[i] = std::atan2(nds[i]->coordinate().y() - sc.y(),
+                                  nds[i]->coordinate().x() - sc.x());
+        std::sort(sensors.begin(), sensors.end(),
+                  [&angle](const size_type& a, const size_type& b) {
+                      return angle[a] < angle[b];
+                  });
+
+        // positions of the sensors of each tile, by angle.
+        res.tiles = std::max(size_type(1), std::min(cfg.tiles, sensors.size()));
+        std::vector<std::vector<size_type>> members(res.tiles);
+        for (size_type t = 0; t < res.tiles; ++t)
+            members[t].assign(sensors.begin() + t * sensors.size() / res.tiles,
+                              sensors.begin() + (t + 1) * sensors.size() / res.tiles);
+
+        // angular distance of angle a from the sector [lo, hi].
+        auto apart = [](const double& a, const double& lo, const double& hi) {
+            if (lo <= a && a <= hi)
+                return 0.0;
+            return std::min(std::fabs(std::remainder(a - lo, 2 * M_PI)),
+                            std::fabs(std::remainder(a - hi, 2 * M_PI)));
+        };
+
+        // positions (in nds) of the relays of each tile, and whether
+        // it found a feasible placement.
+        std::vector<std::vector<size_type>> placed(res.tiles);
+        std::vector<char>                   ok(res.tiles, 0);
+        std::vector<size_type>              pending;
+        for (size_type t = 0; t < res.tiles; ++t)
+            pending.push_back(t);
+        std::vector<Workspace> ws(std::max(size_type(1),
+                                  std::min(hardware_threads(cfg.threads), res.tiles)));
+
+        double margin = res.tiles == 1 ? M_PI : cfg.overlap;
+        while (!pending.empty()) {
+            parallel_for(pending.size(), cfg.threads, [&](const size_type& k,
+                                                         const size_type& w) {
+                const size_type t = pending[k];
+                const double    lo = angle[members[t].front()];
+                const double    hi = angle[members[t].back()];
+                std::vector<Node*>      sub(1, nds[src]);
+                std::vector<size_type>  pos(1, src);
+
+                for (auto &j : members[t]) {
+                    sub.push_back(nds[j]);
+                    pos.push_back(j);
+                }
+                for (auto &c : cdls)
+                    if (margin >= M_PI || distance(*nds[c], *nds[src]) <= cfg.core ||
+                        apart(angle[c], lo, hi) <= margin) {
+                        sub.push_back(nds[c]);
+                        pos.push_back(c);
+                    }
+
+                Topology topo(sub, model);
+                Workspace& wk = ws[w];
+                std::set<size_type> y = relay_placement(topo, strategy, wk);
+                // with relays placed, only the kept ones are active.
+                std::vector<char> keep(topo.size(), 0);
+                placed[t].clear();
+                for (size_type i = 0; !y.empty() && i < topo.size(); ++i)
+                    if (topo.type(i) == NodeType::CDL && wk.active[i]) {
+                        keep[i] = 1;
+                        placed[t].push_back(pos[i]);
+                    }
+                wk.reset(topo);
+                for (size_type i = 0; i < topo.size(); ++i)
+                    wk.active[i] = topo.type(i) != NodeType::CDL || keep[i];
+                ok[t] = hop_feasibility(topo, wk) == spt_status::OK;
+                if (!ok[t])
+                    placed[t].clear();
+            });
+
+            std::vector<size_type> failed;
+            for (auto &t : pending)
+                if (!ok[t])
+                    failed.push_back(t);
+            if (failed.empty() || margin >= M_PI)
+                break;
+            margin = std::min(2 * margin, M_PI);
+            res.retries += failed.size();
+            pending.swap(failed);
+            // once tiles span the whole field, solve what is left as
+            // a single tile rather than once per tile.
+            if (margin >= M_PI && pending.size() > 1) {
+                std::vector<size_type> rest;
+                for (auto &t : pending)
+                    rest.insert(rest.end(), members[t].begin(), members[t].end());
+                members.push_back(rest);
+                placed.push_back(std::vector<size_type>());
+                ok.push_back(0);
+                res.merged = pending.size();
+                ++res.tiles;
+                pending.assign(1, members.size() - 1);
+            }
+        }
+
+        // stitch the tiles over the sink, the sensors and their relays.
+        std::set<size_type> chosen;
+        for (auto &p : placed) {
+            res.tile_relays += p.size();
+            chosen.insert(p.begin(), p.end());
+        }
+        std::vector<Node*> sub;
+        for (size_type i = 0; i < nds.size(); ++i)
+            if (nds[i]->type() != NodeType::CDL || chosen.count(i))
+                sub.push_back(nds[i]);
+        Topology  topo(sub, model);
+        Workspace wk;
+        wk.reset(topo);
+        res.feasible = hop_feasibility(topo, wk) == spt_status::OK;
+        if (!res.feasible)
+            return res;
+        if (strategy.prune())
+            for (size_type i = 0; i < topo.size(); ++i)
+                if (topo.type(i) == NodeType::CDL)
+                    prune_relay(topo, wk, i);
+        res.relays = placed_relays(topo, wk);
+        return res;
+    }
+}
+
+#endif
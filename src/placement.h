@@ -0,0 +1,408 @@
+#ifndef NDRNP_PLACEMENT_H
+#define NDRNP_PLACEMENT_H
+
+#include <iostream>
+#include <vector>
+#include <stdexcept>
+#include <set>
+#include <map>
+#include <utility>     // pair
+#include <algorithm>   // sort(), lower_bound()
+
+#include "header.h"
+#include "node.h"
+#include "graph_misc.h"
+#include "cover.h"
+#include "cover_strategy.h"
+#include "topology.h"
+#include "bitset.h"
+
+namespace ndrnp {
+    // type declarations.
+    struct Workspace;
+    class SolverContext;
+
+    /* @struct Workspace
+     * Per-run state of relay_placement() over a Topology, so that the
+     * topology itself is never modified:
+     *   hop      - hop budget of each node, tightened layer by layer,
+     *   dist     - hop distance of each node from the sink,
+     *   active   - whether each node transmits; an inactive node is
+     *              treated as if its power were 0,
+     *   selected - whether each node has been chosen as a relay,
+     *   queue    - breadth first search queue,
+     *   ik, next - the layer being covered and the next one,
+     *   near     - the sink and the nodes it reaches directly, which
+     *              never need to be covered,
+     *   slack    - the most hops a node may be from the sink and still
+     *              lead some sensor within its constraint (see
+     *              prune_candidates()),
+     *   fam      - (key, element) pairs of the family of the layer,
+     *   cover    - the cover instance of the layer, refilled from fam.
+     * A workspace may be reused by successive runs, one at a time;
+     * reset() clears every buffer but keeps its capacity, so runs on
+     * topologies of similar size hardly allocate.
+     */
+    struct Workspace {
+        void reset(const Topology&);
+
+        std::vector<hop_type>     hop;
+        std::vector<hop_type>     dist;
+        std::vector<char>         active;
+        std::vector<char>         selected;
+        std::vector<size_type>    queue;
+        std::vector<size_type>    ik;
+        std::vector<size_type>    next;
+        Bitset                    near;
+        std::vector<hop_type>     slack;
+        std::vector<std::pair<size_type, size_type>>    fam;
+        Cover<size_type, size_type>                     cover;
+    };
+
+    void
+    Workspace::reset(const Topology& topo) {
+        hop.assign(topo.size(), 0);
+        for (size_type i = 0; i < topo.size(); ++i)
+            hop[i] = topo.hop(i);
+        dist.assign(topo.size(), 9999);
+        active.assign(topo.size(), 1);
+        selected.assign(topo.size(), 0);
+        queue.clear();
+        ik.clear();
+        next.clear();
+        near.assign(topo.size());
+        slack.assign(topo.size(), -1);
+        fam.clear();
+    }
+
+    /* @fn hop_distances()
+     * Breadth first search from the sink over the active nodes,
+     * storing hop distances in ws.dist (9999 if unreachable).
+     * @return spt_status::BAD_VERTEX if no sink is given,
+     * spt_status::DISCONNECTED if some sensor cannot be reached,
+     * spt_status::OK otherwise.
+     */
+    spt_status
+    hop_distances(const Topology& topo, Workspace& ws) {
+        size_type src = topo.sink();
+
+        if (src >= topo.size())
+            return spt_status::BAD_VERTEX;
+        ws.dist.assign(topo.size(), 9999);
+        ws.queue.clear();
+        ws.dist[src] = 0;
+        ws.queue.push_back(src);
+        for (size_type head = 0; head < ws.queue.size(); ++head) {
+            size_type v = ws.queue[head];
+            for (auto &u : topo.out(v))
+                if (ws.active[u] && ws.dist[u] > ws.dist[v] + 1) {
+                    ws.dist[u] = ws.dist[v] + 1;
+                    ws.queue.push_back(u);
+                }
+        }
+
+        for (auto &d : topo.sensors())
+            if (ws.dist[d] == 9999)
+                return spt_status::DISCONNECTED;
+        return spt_status::OK;
+    }
+
+    /* @fn hop_feasibility()
+     * Check whether every sensor reaches the sink through active
+     * nodes within its (original) hop constraint.
+     */
+    spt_status
+    hop_feasibility(const Topology& topo, Workspace& ws) {
+        spt_status st = hop_distances(topo, ws);
+        if (st != spt_status::OK)
+            return st;
+        for (auto &d : topo.sensors())
+            if (ws.dist[d] > topo.hop(d))
+                return spt_status::HOP_VIOLATION;
+        return spt_status::OK;
+    }
+
+    /* @fn first_layer()
+     * Start covering layers: mark the nodes that never need to be
+     * covered in ws.near and put the sensors in ws.ik.
+     * @return the most layers there may be, i.e. the largest hop
+     * constraint of a sensor.
+     */
+    hop_type
+    first_layer(const Topology& topo, Workspace& ws) {
+        const size_type src = topo.sink();
+        hop_type DELTA = 0;
+
+        for (auto &d : topo.sensors())
+            if (DELTA < ws.hop[d])
+                DELTA = ws.hop[d];
+        ws.near.set(src);
+        for (auto &e : topo.out(src))
+            ws.near.set(e);
+        ws.ik.assign(topo.sensors().begin(), topo.sensors().end());
+        return DELTA;
+    }
+
+    /* @fn layer_family()
+     * For each node in ws.ik, find the nodes that can effectively
+     * cover it, i.e. its incoming neighbors meeting its delay
+     * constraint, as (key, element) pairs sorted in ws.fam.
+     */
+    void
+    layer_family(const Topology& topo, Workspace& ws) {
+        ws.fam.clear();
+        for (auto &u : ws.ik)
+            for (auto &v : topo.in(u))
+                if (ws.dist[v] < ws.hop[u])
+                    ws.fam.push_back(std::make_pair(v, u));
+        std::sort(ws.fam.begin(), ws.fam.end());
+    }
+
+    /* @fn next_layer()
+     * Take the cover tmp of the layer in ws.ik: update the delay
+     * constraints of its nodes, mark its CDLs selected, and make the
+     * chosen nodes that are not neighbors of the sink the next layer.
+     */
+    void
+    next_layer(const Topology& topo, const std::set<size_type>& tmp, Workspace& ws) {
+        // for each node in minimum set cover update its delay constraint.
+        for (auto &e : tmp)
+            for (auto p = std::lower_bound(ws.fam.begin(), ws.fam.end(),
+                              std::make_pair(e, size_type(0)));
+                 p != ws.fam.end() && p->first == e; ++p)
+                // p's constraint may have been tightened earlier in this
+                // round (p is chosen too); e cannot be its parent then.
+                if (ws.hop[e] > ws.hop[p->second] - 1 &&
+                    ws.dist[e] <= ws.hop[p->second] - 1)
+                    ws.hop[e] = ws.hop[p->second] - 1;
+        // record the placed relay nodes, and cover next the chosen
+        // nodes that are not neighbors of the src.
+        ws.next.clear();
+        for (auto &e : tmp) {
+            if (topo.type(e) == NodeType::CDL)
+                ws.selected[e] = 1;
+            if (!ws.near.test(e))
+                ws.next.push_back(e);
+        }
+        ws.ik.swap(ws.next);
+    }
+
+    /* @fn cover_layers()
+     * Select relays on the CDLs of topo so that every sensor reaches
+     * the (single) sink within its hop constraint. Sensors are
+     * covered layer by layer, from the sensors toward the sink, each
+     * layer with the given cover strategy.
+     * On success ws.selected marks the selected relays, and they are
+     * the only active CDLs.
+     * @return false if no relay is needed or no placement is found,
+     * e.g. the strategy covers no layer within its limits.
+     */
+    template <class Strategy>
+    bool
+    cover_layers(const Topology& topo, const Strategy& strategy, Workspace& ws) {
+        ws.reset(topo);
+        // if the sensors and the sink alone meet the delay
+        // constraints, an empty set will be returned; otherwise
+        // try to build with relays.
+        for (size_type i = 0; i < topo.size(); ++i)
+            ws.active[i] = topo.type(i) != NodeType::CDL;
+        if (hop_feasibility(topo, ws) == spt_status::OK)
+            return false;
+
+        // record the shortest distances (i.e., least hops) between
+        // the sink and all other nodes, including sensors and relays.
+        ws.active.assign(topo.size(), 1);
+        if (hop_feasibility(topo, ws) != spt_status::OK)
+            return false;
+
+// main step begins.
+        hop_type DELTA = first_layer(topo, ws);
+        int k = 0;
+        // main loop.
+        while (!ws.ik.empty()) {
+            if (k++ > DELTA)
+                return false;
+            // the delay constraints are updated with respect to the
+            // full family (see next_layer()), keep it in fam before the
+            // strategy reduces the cover built from it.
+            layer_family(topo, ws);
+            ws.cover.assign(ws.fam.begin(), ws.fam.end(), ws.ik.begin(), ws.ik.end());
+            // cover this layer.
+            std::set<size_type> tmp = strategy(ws.cover);
+            if (tmp.empty())
+                return false;
+            next_layer(topo, tmp, ws);
+        }
+
+        for (size_type i = 0; i < topo.size(); ++i)
+            if (topo.type(i) == NodeType::CDL && !ws.selected[i])
+                ws.active[i] = 0;
+        return true;
+    }
+
+    /* @fn prune_relay()
+     * Deactivate active relay i if the constraints still hold
+     * without it.
+     * @return true if i is removed.
+     */
+    bool
+    prune_relay(const Topology& topo, Workspace& ws, const size_type& i) {
+        ws.active[i] = 0;
+        if (hop_feasibility(topo, ws) == spt_status::OK)
+            return true;
+        ws.active[i] = 1;
+        return false;
+    }
+
+    /* @fn placed_relays()
+     * Ids of the active CDLs of ws.
+     */
+    std::set<size_type>
+    placed_relays(const Topology& topo, const Workspace& ws) {
+        std::set<size_type> res;
+        for (size_type i = 0; i < topo.size(); ++i)
+            if (topo.type(i) == NodeType::CDL && ws.active[i])
+                res.insert(topo.id(i));
+        return res;
+    }
+
+    /* @fn prune_candidates()
+     * Remove from topo the CDLs that lie on no hop feasible path, i.e.
+     * every CDL r but those with hop(sink, r) + hop(r, s) <= hop(s)
+     * for some sensor s. hop(sink, r) comes from a breadth first
+     * search from the sink; the slack max over s of hop(s) - hop(r, s)
+     * from a multi-source search backward from the sensors, each
+     * starting at its constraint, run over buckets of equal slack.
+     * Every node of a feasible path passes the test, so the hop
+     * distances, layer families and placements of the solver are
+     * unchanged; it only has fewer nodes to go through.
+     * The pass needs the links, so it runs on a built topology: the
+     * cost of linking (see Topology::link()) is paid for every CDL,
+     * removed or not, and only the solver's work is saved. It is thus
+     * worth running when many CDLs are out of reach of the sensors.
+     * @return the number of CDLs removed.
+     */
+    size_type
+    prune_candidates(Topology& topo, Workspace& ws) {
+        std::vector<std::vector<size_type>> buckets;
+        std::vector<size_type>              useless;
+
+        ws.reset(topo);
+        if (hop_distances(topo, ws) == spt_status::BAD_VERTEX)
+            return 0;
+        for (auto &d : topo.sensors())
+            if (ws.dist[d] != 9999 && topo.hop(d) >= 0) {
+                if (buckets.size() <= size_type(topo.hop(d)))
+                    buckets.resize(topo.hop(d) + 1);
+                if (ws.slack[d] < topo.hop(d)) {
+                    ws.slack[d] = topo.hop(d);
+                    buckets[topo.hop(d)].push_back(d);
+                }
+            }
+        // the largest slack first, so each node is settled once.
+        for (size_type k = buckets.size(); k-- > 0; )
+            for (size_type j = 0; j < buckets[k].size(); ++j) {
+                size_type u = buckets[k][j];
+                if (ws.slack[u] != hop_type(k) || k == 0)
+                    continue;
+                for (auto &v : topo.in(u))
+                    if (ws.slack[v] < hop_type(k) - 1) {
+                        ws.slack[v] = k - 1;
+                        buckets[k - 1].push_back(v);
+                    }
+            }
+
+        for (size_type i = 0; i < topo.size(); ++i)
+            if (topo.type(i) == NodeType::CDL && !topo.removed(i) &&
+                (ws.dist[i] == 9999 || ws.slack[i] < ws.dist[i]))
+                useless.push_back(i);
+        topo.remove(useless);
+        return useless.size();
+    }
+
+    /* @fn relay_placement()
+     * Place relay nodes on the CDLs of topo (see cover_layers()),
+     * then prune the selected relays one by one as long as the
+     * constraints still hold, if the strategy allows it.
+     * All per-run state is kept in ws, so concurrent runs may share
+     * one topology as long as each has its own workspace.
+     * @return ids of the selected CDLs, or an empty set if no relay
+     * is needed or no placement is found.
+     */
+    template <class Strategy>
+    std::set<size_type>
+    relay_placement(const Topology& topo, const Strategy& strategy,
+                    Workspace& ws) {
+        if (!cover_layers(topo, strategy, ws))
+            return std::set<size_type>();
+// try to delete each selected relay node, unless redundant
+// parents were asked for.
+        if (strategy.prune())
+            for (size_type i = 0; i < topo.size(); ++i)
+                if (ws.selected[i])
+                    prune_relay(topo, ws, i);
+        return placed_relays(topo, ws);
+    }
+
+    /* @class SolverContext
+     * A topology and a workspace kept between solves of node sets of
+     * similar size, e.g. the instances of a batch run. Both are
+     * refilled in place, so repeated solves hardly allocate beyond
+     * what the cover strategy itself needs.
+     */
+    class SolverContext {
+    public:
+        SolverContext() = default;
+        SolverContext(const SolverContext&) = delete;
+        SolverContext& operator=(const SolverContext&) = delete;
+
+        // solve over nds, once the CDLs on no hop feasible path are
+        // dropped if so set (see prune_candidates()); once relays are
+        // placed, the power of every unselected CDL is set to 0, so the
+        // resulting network can be built from nds directly.
+        template <class Strategy>
+        std::set<size_type> solve(const std::vector<Node*>&, const Strategy&);
+
+        // whether solve() drops the CDLs on no hop feasible path
+        // first, by default not.
+        void set_prune_candidates(const bool& p) { prune = p; }
+        bool prune_candidates() const { return prune; }
+
+        const Topology&  topology() const { return topo; }
+        const Workspace& workspace() const { return ws; }
+
+    private:
+        Topology     topo;
+        Workspace    ws;
+        bool         prune = false;
+    };
+
+    template <class Strategy>
+    std::set<size_type>
+    SolverContext::solve(const std::vector<Node*>& nds, const Strategy& strategy) {
+        topo.assign(nds);
+        if (prune)
+            ndrnp::prune_candidates(topo, ws);
+        std::set<size_type> y_hat = relay_placement(topo, strategy, ws);
+
+        // no relay is placed at all if the sensors alone suffice.
+        if (!y_hat.empty())
+            for (size_type i = 0; i < nds.size(); ++i)
+                if (topo.type(i) == NodeType::CDL && !ws.active[i])
+                    nds[i]->set_power(0.0);
+        return y_hat;
+    }
+
+    /* @fn relay_placement()
+     * As above, over the topology given by nds (see
+     * SolverContext::solve()).
+     */
+    template <class Strategy>
+    std::set<size_type>
+    relay_placement(const std::vector<Node *>& nds, const Strategy& strategy) {
+        SolverContext    ctx;
+        return ctx.solve(nds, strategy);
+    }
+}
+
+#endif
@@ -0,0 +1,103 @@
+#ifndef NDRNP_POWER_H
+#define NDRNP_POWER_H
+
+#include <vector>
+#include <cmath>       // isnan()
+
+#include "header.h"
+#include "node.h"
+#include "prr.h"
+#include "topology.h"
+#include "placement.h"
+
+namespace ndrnp {
+    // discrete transmit power levels (absolute dBm, as Node::power()),
+    // those of a CC2420 radio but 0 dBm, since a power of 0 means
+    // the node is off.
+    const std::vector<Node::power_type> POWER_LEVELS = {1, 3, 5, 7, 10, 15, 25};
+
+    // function declarations.
+    std::vector<size_type> routing_tree(const std::vector<Node*>&, const Topology&,
+                                        Workspace&);
+    std::vector<Node::power_type> assign_power(const std::vector<Node*>&,
+                                               const Topology&, Workspace&,
+                                               const std::vector<Node::power_type>& =
+                                                   POWER_LEVELS,
+                                               const PrrModel& = PrrModel());
+
+    /* @fn routing_tree()
+     * Shortest path tree (in hops) from the sink over the active
+     * nodes of ws, each node taking as parent its nearest active
+     * in-neighbor one hop closer to the sink. nds must be the nodes
+     * topo was built from.
+     * @return the parent position of each node, topo.size() for the
+     * sink and the nodes the sink does not reach.
+     */
+    std::vector<size_type>
+    routing_tree(const std::vector<Node*>& nds, const Topology& topo, Workspace& ws) {
+        std::vector<size_type> parent(topo.size(), topo.size());
+
+        if (hop_distances(topo, ws) == spt_status::BAD_VERTEX)
+            return parent;
+        for (size_type v = 0; v < topo.size(); ++v) {
+            if (!ws.active[v] || v == topo.sink() || ws.dist[v] == 9999)
+                continue;
+            for (auto &u : topo.in(v))
+                if (ws.active[u] && ws.dist[u] + 1 == ws.dist[v] &&
+                    (parent[v] == topo.size() ||
+                     distance(*nds[u], *nds[v]) < distance(*nds[parent[v]], *nds[v])))
+                    parent[v] = u;
+        }
+        return parent;
+    }
+
+    /* @fn assign_power()
+     * Lowest power level for every active node of ws (e.g. after
+     * relay_placement()) that still keeps its uplink, i.e. the
+     * routing tree link to its parent (see routing_tree()), at
+     * PRR_CONSTRAINT or above.
+     * A link depends on the power of its sender only, the receiver
+     * just has to be on (see is_neighbor()); so a parent needs no
+     * more power for the links of its children, and every sensor
+     * still reaches the sink over its tree path: the hop constraints
+     * met before are met after.
+     * Each node needs only the level covering its uplink, without
+     * rebuilding the graph per level.
+     * @param levels power levels, in any order.
+     * @return the power of each node: the weakest level keeping its
+     * uplink, its current power if no level weaker than it does (or
+     * it has no parent, as the sink), and 0 for inactive nodes. Every
+     * active node keeps a power above 0, so it still receives.
+     * Nothing of nds is modified.
+     */
+    std::vector<Node::power_type>
+    assign_power(const std::vector<Node*>& nds, const Topology& topo, Workspace& ws,
+                 const std::vector<Node::power_type>& levels, const PrrModel& model) {
+        std::vector<size_type>         parent = routing_tree(nds, topo, ws);
+        std::vector<double>            reach(topo.size(), -1.0);
+        std::vector<Node::power_type>  power(topo.size(), 0.0);
+
+        for (size_type v = 0; v < topo.size(); ++v)
+            if (parent[v] != topo.size())
+                reach[v] = distance(*nds[v], *nds[parent[v]]);
+
+        for (size_type v = 0; v < topo.size(); ++v) {
+            if (!ws.active[v])
+                continue;
+            power[v] = nds[v]->power();
+            if (reach[v] < 0.0)
+                continue;
+            // the larger the absolute value, the weaker the level, so
+            // a node with a link, whose power is above 0, stays on.
+            for (auto &l : levels)
+                if (l > power[v]) {
+                    double p = model.prr(l, reach[v]);
+                    if (!std::isnan(p) && p >= PRR_CONSTRAINT)
+                        power[v] = l;
+                }
+        }
+        return power;
+    }
+}
+
+#endif
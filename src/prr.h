@@ -8,6 +8,7 @@
 #define NDRNP_PRR_H
 
 #include <cmath>
+#include <limits>
 
 namespace ndrnp {
     // total bits to be sent
@@ -29,11 +30,37 @@ namespace ndrnp {
     // reference distance (in m)
     const double d0 = 1;
 
+    // type declarations.
+    struct PrrModel;
+
+    /* @struct PrrModel
+     * Parameters of the path loss model above, defaulting to its
+     * constants, so that the model can be varied at run time (e.g.
+     * by a parameter sweep).
+     */
+    struct PrrModel {
+        double snr(double, double) const;
+        double ber(double, double) const;
+        double prr(double, double) const;
+        double range(double, double) const;
+
+        double    bits = BITS;
+        double    ple = ndrnp::ple;
+        double    dr = ndrnp::dr;
+        double    nb = ndrnp::nb;
+        // standard deviation due to multipath effects.
+        double    sigma = ndrnp::std;
+        double    pl0 = ndrnp::pl0;
+        double    nf = ndrnp::nf;
+        double    d0 = ndrnp::d0;
+    };
+
     /* @fn snr
      * Compute the average SNR at distance d with 
      * set transmit power to pt.
      */
-    double snr(double pt, double d) {
+    double
+    PrrModel::snr(double pt, double d) const {
         return pt - pl0 - 10 * ple * std::log10(d / d0) - nf;
     }
     /* @fn q_func
@@ -46,17 +73,62 @@ namespace ndrnp {
      * Compute the bit error rate at distance d with
      * transmit power set to pt.
      */
-    double ber(double pt, double d) {
+    double
+    PrrModel::ber(double pt, double d) const {
         return q_func(std::sqrt(2 * snr(pt, d) * nb / dr));
     }
     /* @fn prr
      * Compute the packet reception rate at distance d
      * with transmit power set to pt.
      */
-    double prr(double pt, double d) {
+    double
+    PrrModel::prr(double pt, double d) const {
         double p = - pt;
-        return std::pow(1.0 - ber(p, d), 8 * BITS);
+        return std::pow(1.0 - ber(p, d), 8 * bits);
     }
+
+    /* @fn range
+     * Distance up to which the packet reception rate with transmit
+     * power set to pt stays at p_min or above, found by bisection to
+     * a relative precision of 1e-12. The rate only falls with the
+     * distance, so a link may be decided by comparing its length to
+     * this range, away from the range itself.
+     * Return 0 if no distance down to 1e-6 * d0 reaches p_min, and
+     * infinity if the rate does not fall with the distance (ple <= 0)
+     * or never falls below p_min.
+     */
+    double
+    PrrModel::range(double pt, double p_min) const {
+        const double inf = std::numeric_limits<double>::infinity();
+        auto reached = [&](const double& d) {
+            double p = prr(pt, d);
+            return !std::isnan(p) && p >= p_min;
+        };
+        double lo = 1e-6 * d0, hi = d0;
+
+        if (!(ple > 0.0))
+            return inf;
+        if (!reached(lo))
+            return 0.0;
+        for (; reached(hi); hi *= 2) {
+            lo = hi;
+            if (hi > 1e15)
+                return inf;
+        }
+        while (hi - lo > lo * 1e-12) {
+            double mid = lo + (hi - lo) / 2;
+            if (reached(mid))
+                lo = mid;
+            else
+                hi = mid;
+        }
+        return lo;
+    }
+
+    // the same with the default model.
+    double snr(double pt, double d) { return PrrModel().snr(pt, d); }
+    double ber(double pt, double d) { return PrrModel().ber(pt, d); }
+    double prr(double pt, double d) { return PrrModel().prr(pt, d); }
 }
 
 #endif
@@ -3,6 +3,7 @@
 
 #include <vector>
 #include <set>
+#include <stdexcept>
 
 #include "header.h"
 #include "node.h"
@@ -11,20 +12,30 @@
 #include "prr.h"
 
 namespace ndrnp {
+    /* @fn restore_nodes()
+     * Restore the sink, then the cfg.sensor_num sensors (power ps and
+     * hop constraint hs), then the CDLs (power pr) of nds, in this
+     * order, after a solver changed them.
+     * @throw std::range_error if nds or the values do not match cfg.
+     */
     void
     restore_nodes(const std::vector<Node*>& nds,
                   const std::vector<Node::power_type>& ps,
                   const std::vector<Node::power_type>& pr,
-                  const std::vector<hop_type>& hs) {
+                  const std::vector<hop_type>& hs,
+                  const RunConfig& cfg = RunConfig()) {
+        if (nds.size() < cfg.sensor_num + 1 || ps.size() < cfg.sensor_num ||
+            hs.size() < cfg.sensor_num || pr.size() < nds.size() - cfg.sensor_num - 1)
+            throw std::range_error("Nodes do not match the run configuration");
 
         nds[0]->set_power(5.0);
-        for (size_type i = 1; i < sensor_num + 1; ++i) {
+        for (size_type i = 1; i < cfg.sensor_num + 1; ++i) {
             nds[i]->set_hop(hs[i - 1]);
             nds[i]->set_power(ps[i - 1]);
         }
-        for (size_type i = sensor_num + 1; i < nds.size(); ++i) {
+        for (size_type i = cfg.sensor_num + 1; i < nds.size(); ++i) {
             nds[i]->set_hop(9999);
-            nds[i]->set_power(pr[i - sensor_num - 1]);
+            nds[i]->set_power(pr[i - cfg.sensor_num - 1]);
         }
     }
 
@@ -65,29 +76,43 @@ namespace ndrnp {
         hop += 10.0;
         return hop / dests.size();
     }
+    /* @fn check_power_level()
+     * The transmit power levels average_energy() knows: 0, 1 and 2.
+     * @throw std::range_error for any other level.
+     */
+    void
+    check_power_level(const double& level) {
+        if (level != 0 && level != 1 && level != 2)
+            throw std::range_error("Power level must be 0, 1 or 2");
+    }
+
+    /* @fn forwarding_energy()
+     * Energy per forwarding node of tx transmissions shared by the
+     * given number of forwarding nodes, at the given power level:
+     * each transmission costs its sending energy at that level plus
+     * 24 to receive, and 10 transmissions are added for the sink.
+     * @throw std::range_error for a level other than 0, 1 or 2.
+     */
+    double
+    forwarding_energy(double tx, const size_type& forwarders, const int& level) {
+        check_power_level(level);
+        tx += 10.0;
+        return (tx * (level == 0 ? 26 : level == 1 ? 25 : 24) + tx * 24) /
+               (forwarders + 1.0);
+    }
+
     double 
     average_energy(const AdjacencyList<Node*>& al, 
                    const std::vector<size_type>& dests,
                    int i) {
-        double hop = 0.0, energy;
+        double hop = 0.0;
         std::set<size_type>   num;
         for (auto &d : dests)
             for (size_type p = d; al[p].parent() != 0;
                  p = al[p].parent()) {
                 ++hop; num.insert(p);
             }
-        hop += 10.0;
-        switch (i) {
-            case 0:
-                energy = hop * 26; break;
-            case 1:
-                energy = hop * 25; break;
-            case 2:
-                energy = hop * 24; break;
-
-        }
-        energy += hop * 24;
-        return energy / (num.size() + 1.0);
+        return forwarding_energy(hop, num.size(), i);
     }
 
     double
@@ -98,12 +123,13 @@ namespace ndrnp {
 
     double
     average_prr(const AdjacencyList<Node*>& al,
-                const std::vector<size_type>& dests) {
+                const std::vector<size_type>& dests,
+                const PrrModel& model = PrrModel()) {
       double pr = 0.0;
       for (auto& d : dests) {
           double p_prr = 1.0, tmp;
           for (size_type p = d; p != 0; p = al[p].parent()) {
-              tmp = prr(al[p].data()->power(), 
+              tmp = model.prr(al[p].data()->power(), 
                        distance(*(al[p].data()), *(al[al[p].parent()].data())));
               p_prr *= tmp;
           }
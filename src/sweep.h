@@ -0,0 +1,278 @@
+#ifndef NDRNP_SWEEP_H
+#define NDRNP_SWEEP_H
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <functional>
+#include <stdexcept>
+#include <iomanip>     // setprecision()
+#include <limits>
+#include <cmath>       // floor()
+
+#include "header.h"
+#include "cover_strategy.h"
+#include "monte_carlo.h"
+
+/*
+ * Parameter sweeps: every combination of the parameter values given
+ * in a config file is evaluated with monte_carlo().
+ *
+ * A config file holds one "key = value" setting per line; text after
+ * '#' is ignored. Swept parameters take a comma separated list of
+ * values or an inclusive range "first:last:step":
+ *     sink_num, sensor_num, cdl_num   - node counts (one sink only),
+ *     hop                             - hop constraint of every sensor
+ *                                       (1 to 9998, as 9999 means
+ *                                       none),
+ *     tx                              - transmit power (absolute dBm),
+ *     link_delay, field, power_level  - see ExperimentPoint (a power
+ *                                       level is 0, 1 or 2),
+ *     bits, ple, dr, nb, std, pl0,
+ *     nf, d0                          - PRR model, see prr.h.
+ * The other settings take a single value:
+ *     solvers - comma separated solver names (see sweep_solver()),
+ *     trials, seed, threads.
+ * Parameters not given keep the defaults of ExperimentPoint.
+ */
+
+namespace ndrnp {
+    // type declarations.
+    struct SweepConfig;
+
+    // function declarations.
+    double sweep_integer(const std::string&, const double&, const double&,
+                         const double&);
+    SweepConfig read_sweep_config(std::istream&);
+    std::vector<ExperimentPoint> sweep_points(const SweepConfig&);
+    Solver sweep_solver(const std::string&, const unsigned&);
+    void sweep(const SweepConfig&, std::ostream&);
+
+    /* @struct SweepConfig
+     * Values of each swept parameter, in the order given, and the
+     * settings shared by every point.
+     */
+    struct SweepConfig {
+        std::vector<std::pair<std::string, std::vector<double>>>  params;
+        std::vector<std::string>                                  solvers;
+        size_type    trials = 100;
+        size_type    threads = 0;
+        unsigned     seed = 0;
+    };
+
+    /* @fn sweep_integer()
+     * Value v of the named parameter, checked to be an integer in
+     * [lo, hi] before it is stored into an integral field.
+     * @throw std::range_error otherwise.
+     */
+    double
+    sweep_integer(const std::string& name, const double& v, const double& lo,
+                  const double& hi) {
+        if (!(v >= lo && v <= hi) || v != std::floor(v)) {
+            std::ostringstream os;
+            os << name << " must be an integer from " << std::fixed
+               << std::setprecision(0) << lo << " to " << hi;
+            throw std::range_error(os.str());
+        }
+        return v;
+    }
+
+    /* @fn sweep_setter()
+     * Function storing a value of the named swept parameter into a
+     * point, or an empty function if no such parameter exists.
+     */
+    std::function<void(ExperimentPoint&, const double&)>
+    sweep_setter(const std::string& name) {
+        typedef std::function<void(ExperimentPoint&, const double&)>  setter_type;
+        static const std::map<std::string, setter_type> setters = {
+            {"sink_num", [](ExperimentPoint& p, const double& v) {
+                if (v != 1)
+                    throw std::range_error("Only one sink is supported");
+                p.counts.sink_num = v;
+            }},
+            // every node needs an id.
+            {"sensor_num", [](ExperimentPoint& p, const double& v) {
+                p.counts.sensor_num = sweep_integer("sensor_num", v, 0,
+                                          std::numeric_limits<id_type>::max());
+            }},
+            {"cdl_num", [](ExperimentPoint& p, const double& v) {
+                p.counts.cdl_num = sweep_integer("cdl_num", v, 0,
+                                       std::numeric_limits<id_type>::max());
+            }},
+            {"hop", [](ExperimentPoint& p, const double& v) {
+                p.hop_min = p.hop_max = sweep_integer("hop", v, 1, 9998);
+            }},
+            {"tx", [](ExperimentPoint& p, const double& v) { p.power = v; }},
+            {"link_delay", [](ExperimentPoint& p, const double& v) { p.link_delay = v; }},
+            {"field", [](ExperimentPoint& p, const double& v) { p.field = v; }},
+            {"power_level", [](ExperimentPoint& p, const double& v) {
+                check_power_level(v);
+                p.power_level = v;
+            }},
+            {"bits", [](ExperimentPoint& p, const double& v) { p.model.bits = v; }},
+            {"ple", [](ExperimentPoint& p, const double& v) { p.model.ple = v; }},
+            {"dr", [](ExperimentPoint& p, const double& v) { p.model.dr = v; }},
+            {"nb", [](ExperimentPoint& p, const double& v) { p.model.nb = v; }},
+            {"std", [](ExperimentPoint& p, const double& v) { p.model.sigma = v; }},
+            {"pl0", [](ExperimentPoint& p, const double& v) { p.model.pl0 = v; }},
+            {"nf", [](ExperimentPoint& p, const double& v) { p.model.nf = v; }},
+            {"d0", [](ExperimentPoint& p, const double& v) { p.model.d0 = v; }}
+        };
+        auto it = setters.find(name);
+        return it == setters.end() ? setter_type() : it->second;
+    }
+
+    /* @fn sweep_values()
+     * Parse "v1, v2, ..." or "first:last:step" into a list of values.
+     */
+    std::vector<double>
+    sweep_values(const std::string& text) {
+        std::vector<double> vs;
+        std::string         item;
+
+        if (text.find(':') != std::string::npos) {
+            std::istringstream is(text);
+            double first, last, step;
+            char   c1, c2;
+            if (!(is >> first >> c1 >> last >> c2 >> step) || c1 != ':' ||
+                c2 != ':' || step <= 0.0 || last < first)
+                throw std::range_error("Bad range: " + text);
+            // tolerate rounding of fractional steps at the end.
+            size_type n = std::floor((last - first) / step + 1e-9);
+            for (size_type i = 0; i <= n; ++i)
+                vs.push_back(first + i * step);
+            return vs;
+        }
+        std::istringstream is(text);
+        while (std::getline(is, item, ',')) {
+            std::istringstream iss(item);
+            double v;
+            if (!(iss >> v))
+                throw std::range_error("Bad value: " + item);
+            vs.push_back(v);
+        }
+        if (vs.empty())
+            throw std::range_error("No value given");
+        return vs;
+    }
+
+    /* @fn read_sweep_config()
+     * Read a sweep configuration (see above).
+     * @throw std::range_error on an unknown key or a malformed value.
+     */
+    SweepConfig
+    read_sweep_config(std::istream& is) {
+        SweepConfig  cfg;
+        std::string  line;
+
+        auto trim = [](const std::string& s) {
+            size_type b = s.find_first_not_of(" \t\r");
+            size_type e = s.find_last_not_of(" \t\r");
+            return b == std::string::npos ? std::string() : s.substr(b, e - b + 1);
+        };
+        while (std::getline(is, line)) {
+            line = trim(line.substr(0, line.find('#')));
+            if (line.empty())
+                continue;
+            size_type eq = line.find('=');
+            if (eq == std::string::npos)
+                throw std::range_error("Expected key = value: " + line);
+            std::string key = trim(line.substr(0, eq));
+            std::string value = trim(line.substr(eq + 1));
+
+            if (key == "solvers") {
+                std::istringstream iss(value);
+                std::string        name;
+                cfg.solvers.clear();
+                while (std::getline(iss, name, ','))
+                    cfg.solvers.push_back(trim(name));
+            } else if (key == "trials")
+                cfg.trials = sweep_values(value).front();
+            else if (key == "threads")
+                cfg.threads = sweep_values(value).front();
+            else if (key == "seed")
+                cfg.seed = sweep_values(value).front();
+            else if (sweep_setter(key))
+                cfg.params.push_back(std::make_pair(key, sweep_values(value)));
+            else
+                throw std::range_error("Unknown key: " + key);
+        }
+        if (cfg.solvers.empty())
+            cfg.solvers.push_back("greedy");
+        return cfg;
+    }
+
+    /* @fn sweep_points()
+     * Cartesian product of the swept parameter values, the last
+     * parameter varying fastest.
+     */
+    std::vector<ExperimentPoint>
+    sweep_points(const SweepConfig& cfg) {
+        ExperimentPoint               base;
+        std::vector<ExperimentPoint>  pts;
+
+        base.trials = cfg.trials;
+        base.seed = cfg.seed;
+        pts.push_back(base);
+        for (auto &param : cfg.params) {
+            auto                          set = sweep_setter(param.first);
+            std::vector<ExperimentPoint>  next;
+            for (auto &p : pts)
+                for (auto &v : param.second) {
+                    next.push_back(p);
+                    set(next.back(), v);
+                }
+            pts.swap(next);
+        }
+        return pts;
+    }
+
+    /* @fn sweep_solver()
+     * Solver given by name, optionally followed by ":parameter":
+     *     greedy, lazy, weight[:degree], random[:runs],
+     *     exact[:milliseconds], kfold[:k].
+     * The randomized solver draws from the given seed.
+     */
+    Solver
+    sweep_solver(const std::string& spec, const unsigned& seed) {
+        size_type    colon = spec.find(':');
+        std::string  name = spec.substr(0, colon);
+        double       arg = colon == std::string::npos ? 0.0 :
+                           sweep_values(spec.substr(colon + 1)).front();
+
+        if (name == "greedy")
+            return make_solver(spec, GreedyStrategy());
+        if (name == "lazy")
+            return make_solver(spec, LazyGreedyStrategy());
+        if (name == "weight")
+            return make_solver(spec, WeightStrategy(arg > 0 ? arg : 4));
+        if (name == "random")
+            return make_solver(spec, RandomStrategy(arg > 0 ? arg : 64, seed, 1));
+        if (name == "exact")
+            return make_solver(spec, ExactStrategy(EXACT_NODE_LIMIT,
+                                         std::chrono::milliseconds(
+                                             static_cast<long>(arg))));
+        if (name == "kfold")
+            return make_solver(spec, KFoldStrategy(arg > 0 ? arg : 2));
+        throw std::range_error("Unknown solver: " + spec);
+    }
+
+    /* @fn sweep()
+     * Evaluate every point of cfg with every solver, writing one
+     * summary row per point and solver.
+     */
+    void
+    sweep(const SweepConfig& cfg, std::ostream& os) {
+        std::vector<Solver> solvers;
+
+        for (auto &s : cfg.solvers)
+            solvers.push_back(sweep_solver(s, cfg.seed));
+        write_summary_header(os);
+        for (auto &ps : monte_carlo(sweep_points(cfg), solvers, cfg.threads))
+            write_summary(os, ps);
+    }
+}
+
+#endif
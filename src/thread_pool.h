@@ -0,0 +1,196 @@
+#ifndef NDRNP_THREAD_POOL_H
+#define NDRNP_THREAD_POOL_H
+
+#include <vector>
+#include <queue>
+#include <deque>
+#include <atomic>
+#include <exception>
+#include <algorithm>   // min()
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <utility>
+#include <stdexcept>
+
+#include "header.h"
+
+namespace ndrnp {
+    // type declarations.
+    class ThreadPool;
+
+    // function declarations.
+    template <class F>
+    void parallel_for(const size_type&, const size_type&, F);
+
+    /* @class ThreadPool
+     * A fixed number of worker threads consuming tasks from
+     * a shared FIFO queue. Each submitted task yields a future
+     * holding its result (or the exception it threw).
+     */
+    class ThreadPool {
+    public:
+        explicit ThreadPool(const size_type& n = 0);
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool(ThreadPool&&) = delete;
+        ~ThreadPool();
+
+        ThreadPool& operator=(const ThreadPool&) = delete;
+        ThreadPool& operator=(ThreadPool&&) = delete;
+
+        template <class F>
+        auto submit(F&&) -> std::future<decltype(std::declval<F>()())>;
+
+        size_type size() const { return workers.size(); }
+
+    private:
+        void work();
+
+    private:
+        std::vector<std::thread>              workers;
+        std::queue<std::function<void()>>     tasks;
+        std::mutex                            mtx;
+        std::condition_variable               cv;
+        bool                                  stop;
+    };
+
+    /* @fn hardware_threads()
+     * Number of threads to use when the caller passes 0,
+     * never less than one.
+     */
+    size_type
+    hardware_threads(const size_type& n = 0) {
+        if (n != 0)
+            return n;
+        size_type hw = std::thread::hardware_concurrency();
+        return hw == 0 ? 1 : hw;
+    }
+
+    ThreadPool::ThreadPool(const size_type& n)
+    : stop(false) {
+        size_type cnt = hardware_threads(n);
+        for (size_type i = 0; i < cnt; ++i)
+            workers.push_back(std::thread(&ThreadPool::work, this));
+    }
+
+    ThreadPool::~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lk(mtx);
+            stop = true;
+        }
+        cv.notify_all();
+        for (auto &w : workers)
+            w.join();
+    }
+
+    template <class F>
+    auto
+    ThreadPool::submit(F&& f) -> std::future<decltype(std::declval<F>()())> {
+        typedef decltype(std::declval<F>()()) result_type;
+        // packaged_task is move-only while std::function requires
+        // a copyable target, so the task is shared instead.
+        auto task = std::make_shared<std::packaged_task<result_type()>>(
+                        std::forward<F>(f));
+        std::future<result_type> res = task->get_future();
+        {
+            std::lock_guard<std::mutex> lk(mtx);
+            if (stop)
+                throw std::runtime_error("submit on stopped thread pool");
+            tasks.push([task]() { (*task)(); });
+        }
+        cv.notify_one();
+        return res;
+    }
+
+    void
+    ThreadPool::work() {
+        while (true) {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lk(mtx);
+                cv.wait(lk, [this]() { return stop || !tasks.empty(); });
+                // drain remaining tasks before leaving.
+                if (stop && tasks.empty())
+                    return;
+                task = std::move(tasks.front());
+                tasks.pop();
+            }
+            task();
+        }
+    }
+    /* @fn parallel_for()
+     * Call f(i, w) for every i in [0, n) on the given number of
+     * threads (see hardware_threads()), w being the index of the
+     * worker making the call, so that f can keep per-worker state.
+     * Indices are dealt out in contiguous blocks, one deque per
+     * worker; a worker takes from the front of its own deque and,
+     * once it is empty, steals from the back of another one, so
+     * tasks of uneven cost still keep every worker busy. The calling
+     * thread is worker 0.
+     * The first exception thrown by f is rethrown once every worker
+     * has stopped; the remaining indices are skipped then.
+     */
+    template <class F>
+    void
+    parallel_for(const size_type& n, const size_type& threads, F f) {
+        struct Lane {
+            std::mutex               mtx;
+            std::deque<size_type>    tasks;
+        };
+        size_type            cnt = std::min(hardware_threads(threads), n);
+        std::vector<Lane>    lanes(cnt);
+        std::vector<std::thread> workers;
+        std::atomic<bool>    failed(false);
+        std::exception_ptr   error;
+        std::mutex           error_mtx;
+
+        if (n == 0)
+            return;
+        for (size_type w = 0; w < cnt; ++w)
+            for (size_type i = n * w / cnt; i < n * (w + 1) / cnt; ++i)
+                lanes[w].tasks.push_back(i);
+
+        auto work = [&](const size_type& w) {
+            while (!failed) {
+                size_type i = n;
+                for (size_type k = 0; k < cnt && i == n; ++k) {
+                    Lane& lane = lanes[(w + k) % cnt];
+                    std::lock_guard<std::mutex> lk(lane.mtx);
+                    if (lane.tasks.empty())
+                        continue;
+                    if (k == 0) {
+                        i = lane.tasks.front();
+                        lane.tasks.pop_front();
+                    } else {
+                        i = lane.tasks.back();
+                        lane.tasks.pop_back();
+                    }
+                }
+                // no task is added once started, so all lanes are done.
+                if (i == n)
+                    return;
+                try {
+                    f(i, w);
+                } catch (...) {
+                    std::lock_guard<std::mutex> lk(error_mtx);
+                    if (!error)
+                        error = std::current_exception();
+                    failed = true;
+                }
+            }
+        };
+
+        for (size_type w = 1; w < cnt; ++w)
+            workers.push_back(std::thread(work, w));
+        work(0);
+        for (auto &t : workers)
+            t.join();
+        if (error)
+            std::rethrow_exception(error);
+    }
+}
+
+#endif
@@ -0,0 +1,356 @@
+#ifndef NDRNP_TOPOLOGY_H
+#define NDRNP_TOPOLOGY_H
+
+#include <vector>
+#include <stdexcept>
+#include <algorithm>   // find(), lower_bound(), remove_if()
+#include <map>
+#include <array>
+#include <cmath>       // sqrt(), floor(), fabs()
+#include <limits>
+#include <cstddef>     // size_t
+
+#include "header.h"
+#include "node.h"
+#include "node_store.h"
+
+namespace ndrnp {
+    // type declarations.
+    class Topology;
+
+    /* @class Topology
+     * Read-only snapshot of a placement instance: the type, id and
+     * hop constraint of every node, and the links between nodes at
+     * their given powers (see is_neighbor()). Nothing refers back
+     * to the Node objects once it is built, so one Topology can be
+     * shared by any number of concurrent solves.
+     * Nodes are referred to by their position in the vector the
+     * topology is built from, whatever their ids are.
+     * A topology owned by a single solver may also be edited node by
+     * node (see update() and remove()), relinking only the nodes
+     * concerned.
+     */
+    class Topology {
+    public:
+        typedef std::vector<size_type>    list_type;
+
+        Topology(): _sink(0), _has_sink(false) {}
+        explicit Topology(const std::vector<Node*>& nds,
+                          const PrrModel& model = PrrModel()) {
+            assign(nds, model);
+        }
+        explicit Topology(const NodeStore& st, const PrrModel& model = PrrModel()) {
+            assign(st, model);
+        }
+
+        // rebuild from nds, keeping the capacity of every buffer so
+        // that a topology can be refilled without allocating. Links
+        // follow the given PRR model (see is_neighbor()).
+        void assign(const std::vector<Node*>&, const PrrModel& = PrrModel());
+        // as above from the nodes of a store, by position.
+        void assign(const NodeStore&, const PrrModel& = PrrModel());
+        // refresh the attributes and links of node i from nds[i], e.g.
+        // after it moved; i may be size() to append nds[i].
+        void update(const std::vector<Node*>&, const size_type&);
+        // drop node i: it keeps its position but loses every link and
+        // is neither a sensor nor the sink any more.
+        void remove(const size_type&);
+        // drop every given node at once, each link list being filtered
+        // once rather than once per dropped neighbor.
+        void remove(const std::vector<size_type>&);
+
+        size_type size() const { return _types.size(); }
+        // position of the sink, size() if no sink is given.
+        size_type sink() const { return _has_sink ? _sink : size(); }
+        // positions of all sensors.
+        const list_type& sensors() const { return _sensors; }
+
+        NodeType type(const size_type& i) const { return _types[i]; }
+        id_type  id(const size_type& i) const { return _ids[i]; }
+        hop_type hop(const size_type& i) const { return _hops[i]; }
+        bool     removed(const size_type& i) const { return _removed[i]; }
+
+        // nodes that node i reaches directly.
+        const list_type& out(const size_type& i) const { return _out[i]; }
+        // nodes reaching node i directly.
+        const list_type& in(const size_type& i) const { return _in[i]; }
+
+    private:
+        template <std::size_t N>
+        void link(const NodeStore&, const PrrModel&);
+        void unlink(const size_type&);
+
+    private:
+        std::vector<NodeType>    _types;
+        std::vector<id_type>     _ids;
+        std::vector<hop_type>    _hops;
+        std::vector<list_type>   _out;
+        std::vector<list_type>   _in;
+        std::vector<char>        _removed;
+        list_type                _sensors;
+        size_type                _sink;
+        bool                     _has_sink;
+        PrrModel                 _model;
+        // nodes of the last assign() from Node objects, kept so that
+        // its arrays are reused.
+        NodeStore                _store;
+    };
+
+    void
+    Topology::assign(const std::vector<Node*>& nds, const PrrModel& model) {
+        // one pass of virtual calls, then the links are found over
+        // dense arrays.
+        _store.assign(nds);
+        assign(_store, model);
+    }
+
+    void
+    Topology::assign(const NodeStore& st, const PrrModel& model) {
+        const size_type n = st.size();
+
+        _types.clear();
+        _ids.clear();
+        _hops.clear();
+        _removed.assign(n, 0);
+        _sensors.clear();
+        _has_sink = false;
+        _model = model;
+        // clear() keeps the capacity of the adjacency lists.
+        _out.resize(n);
+        _in.resize(n);
+        for (size_type i = 0; i < n; ++i) {
+            _out[i].clear();
+            _in[i].clear();
+        }
+
+        for (size_type i = 0; i < n; ++i) {
+            _types.push_back(st.type(i));
+            _ids.push_back(st.id(i));
+            _hops.push_back(st.hop(i));
+            if (st.type(i) == NodeType::SENSOR)
+                _sensors.push_back(i);
+            else if (st.type(i) == NodeType::SINK) {
+                if (_has_sink)
+                    throw std::range_error("Multiple sinks are given");
+                _sink = i;
+                _has_sink = true;
+            }
+        }
+
+        if (st.planar())
+            link<2>(st, model);
+        else
+            link<3>(st, model);
+    }
+
+    /* @fn Topology::link()
+     * Add the links between the nodes of st (see is_neighbor()),
+     * comparing squared distances over N coordinates to the range of
+     * the sending power (see PrrModel::range()): pairs clearly beyond
+     * it are dropped and pairs clearly within it kept, without a sqrt
+     * or a PRR; only pairs at about the range itself, at distance 0
+     * or of a power without a finite range are fully tested, so the
+     * links are those of is_neighbor() exactly.
+     * When every range is finite, nodes are bucketed into a grid of
+     * cells as wide as the longest range, and each node is only
+     * compared with the nodes of its own and adjacent cells, so the
+     * cost follows the number of nodes within range rather than n^2.
+     * Links are added in ascending order either way.
+     */
+    template <std::size_t N>
+    void
+    Topology::link(const NodeStore& st, const PrrModel& model) {
+        typedef std::pair<coordinate_type, coordinate_type>    range_type;
+        typedef std::array<long long, 3>                       cell_type;
+
+        // margin around a range, far above the error of the PRR.
+        const double                                eps = 1e-6;
+        const coordinate_type                       inf =
+            std::numeric_limits<coordinate_type>::infinity();
+        // squared inner and outer range by power.
+        std::map<NodeStore::power_type, range_type>  ranges;
+        const size_type                              n = st.size();
+        std::vector<const range_type*>               rg(n, nullptr);
+        coordinate_type                              reach = 0.0;
+
+        for (size_type i = 0; i < n; ++i) {
+            // a node off reaches nothing and is reached by nothing.
+            if (st.power(i) <= 0.0)
+                continue;
+            auto it = ranges.find(st.power(i));
+            if (it == ranges.end()) {
+                double r = model.range(st.power(i), PRR_CONSTRAINT);
+                range_type ri(0.0, inf);
+                if (r > 0.0 && r < inf)
+                    ri = range_type(r * (1 - eps) * r * (1 - eps),
+                                    r * (1 + eps) * r * (1 + eps));
+                it = ranges.emplace(st.power(i), ri).first;
+            }
+            rg[i] = &it->second;
+            reach = std::max(reach, it->second.second);
+        }
+
+        auto test = [&](const size_type& i, const size_type& j) {
+            coordinate_type d = squared_distance<N>(st, i, j);
+            if (d > rg[i]->second)
+                return;
+            if (d > 0.0 && d < rg[i]->first ? st.power(j) > 0.0 :
+                                               is_neighbor(st, i, j, model) != -1) {
+                _out[i].push_back(j);
+                _in[j].push_back(i);
+            }
+        };
+
+        // cells of side the longest range; coordinates must map to
+        // finite cell indices.
+        reach = std::sqrt(reach);
+        std::vector<cell_type> cell(n);
+        bool gridded = reach > 0.0 && reach < inf;
+        for (size_type i = 0; gridded && i < n; ++i)
+            for (std::size_t k = 0; k < 3; ++k) {
+                coordinate_type c = k < N ? (k == 0 ? st.x(i) : k == 1 ? st.y(i) : st.z(i)) /
+                                            reach : 0.0;
+                if (!(std::fabs(c) < 1e15)) {
+                    gridded = false;
+                    break;
+                }
+                cell[i][k] = static_cast<long long>(std::floor(c));
+            }
+
+        if (!gridded) {
+            for (size_type i = 0; i < n; ++i)
+                for (size_type j = 0; rg[i] != nullptr && j < n; ++j)
+                    if (i != j)
+                        test(i, j);
+            return;
+        }
+
+        // cells and positions, sorted; the adjacent cells differing in
+        // the last used coordinate only are contiguous in it.
+        std::vector<std::pair<cell_type, size_type>> grid(n);
+        std::vector<size_type>                       near;
+        for (size_type i = 0; i < n; ++i)
+            grid[i] = std::make_pair(cell[i], i);
+        std::sort(grid.begin(), grid.end());
+        for (size_type i = 0; i < n; ++i) {
+            if (rg[i] == nullptr)
+                continue;
+            near.clear();
+            const long long da = N == 3 ? 1 : 0;
+            for (long long a = -1; a <= 1; ++a)
+                for (long long b = -da; b <= da; ++b) {
+                    cell_type lo = cell[i], hi = cell[i];
+                    lo[0] += a;
+                    hi[0] += a;
+                    lo[1] += N == 3 ? b : -1;
+                    hi[1] += N == 3 ? b : 1;
+                    lo[N - 1] = cell[i][N - 1] - 1;
+                    hi[N - 1] = cell[i][N - 1] + 1;
+                    for (auto it = std::lower_bound(grid.begin(), grid.end(),
+                                                    std::make_pair(lo, size_type(0)));
+                         it != grid.end() && it->first <= hi; ++it)
+                        if (it->second != i)
+                            near.push_back(it->second);
+                }
+            std::sort(near.begin(), near.end());
+            for (auto &j : near)
+                test(i, j);
+        }
+    }
+
+    void
+    Topology::unlink(const size_type& i) {
+        for (auto &j : _out[i])
+            _in[j].erase(std::find(_in[j].begin(), _in[j].end(), i));
+        for (auto &j : _in[i])
+            _out[j].erase(std::find(_out[j].begin(), _out[j].end(), i));
+        _out[i].clear();
+        _in[i].clear();
+    }
+
+    void
+    Topology::update(const std::vector<Node*>& nds, const size_type& i) {
+        if (i == size()) {
+            _types.push_back(nds[i]->type());
+            _ids.push_back(0);
+            _hops.push_back(0);
+            _removed.push_back(0);
+            _out.push_back(list_type());
+            _in.push_back(list_type());
+        } else {
+            unlink(i);
+            if (_has_sink && _sink == i)
+                _has_sink = false;
+            auto it = std::lower_bound(_sensors.begin(), _sensors.end(), i);
+            if (it != _sensors.end() && *it == i)
+                _sensors.erase(it);
+        }
+        _types[i] = nds[i]->type();
+        _ids[i] = nds[i]->id();
+        _hops[i] = nds[i]->hop();
+        _removed[i] = 0;
+        if (_types[i] == NodeType::SENSOR)
+            _sensors.insert(std::lower_bound(_sensors.begin(), _sensors.end(), i), i);
+        else if (_types[i] == NodeType::SINK) {
+            if (_has_sink)
+                throw std::range_error("Multiple sinks are given");
+            _sink = i;
+            _has_sink = true;
+        }
+
+        for (size_type j = 0; j < size(); ++j) {
+            if (j == i || _removed[j])
+                continue;
+            if (is_neighbor(nds[i], nds[j], _model) != -1) {
+                _out[i].push_back(j);
+                _in[j].push_back(i);
+            }
+            if (is_neighbor(nds[j], nds[i], _model) != -1) {
+                _out[j].push_back(i);
+                _in[i].push_back(j);
+            }
+        }
+    }
+
+    void
+    Topology::remove(const size_type& i) {
+        unlink(i);
+        if (_has_sink && _sink == i)
+            _has_sink = false;
+        auto it = std::lower_bound(_sensors.begin(), _sensors.end(), i);
+        if (it != _sensors.end() && *it == i)
+            _sensors.erase(it);
+        _removed[i] = 1;
+    }
+
+    void
+    Topology::remove(const std::vector<size_type>& is) {
+        std::vector<char> touched(size(), 0);
+        auto gone = [this](const size_type& j) { return _removed[j] != 0; };
+
+        for (auto &i : is) {
+            if (_has_sink && _sink == i)
+                _has_sink = false;
+            _removed[i] = 1;
+        }
+        _sensors.erase(std::remove_if(_sensors.begin(), _sensors.end(), gone),
+                       _sensors.end());
+        for (auto &i : is) {
+            for (auto &j : _out[i])
+                touched[j] = 1;
+            for (auto &j : _in[i])
+                touched[j] = 1;
+            _out[i].clear();
+            _in[i].clear();
+        }
+        for (size_type j = 0; j < size(); ++j)
+            if (touched[j]) {
+                _out[j].erase(std::remove_if(_out[j].begin(), _out[j].end(), gone),
+                              _out[j].end());
+                _in[j].erase(std::remove_if(_in[j].begin(), _in[j].end(), gone),
+                             _in[j].end());
+            }
+    }
+}
+
+#endif
@@ -0,0 +1,74 @@
+#include <random>
+#include <iostream>
+#include <ctime>
+#include <chrono>
+#include <vector>
+#include <set>
+
+#include "../src/header.h"
+#include "../src/node.h"
+#include "../src/topology.h"
+#include "../src/anytime.h"
+
+std::uniform_real_distribution<double> d(0.0, 100.0);
+std::default_random_engine e(std::time(0));
+
+const char*
+phase_name(const ndrnp::anytime_phase& p) {
+    switch (p) {
+    case ndrnp::anytime_phase::COVERED:
+        return "covered";
+    case ndrnp::anytime_phase::PRUNED:
+        return "pruned";
+    case ndrnp::anytime_phase::RESTARTED:
+        return "restarted";
+    default:
+        return "done";
+    }
+}
+
+int main(void) {
+    ndrnp::Nodes nds;
+    ndrnp::id_type id = 0;
+
+    for (int i = 0; i < 400; ++i) {
+        if (i < 1)
+            nds.push_back(new ndrnp::Sink(ndrnp::Coordinate(d(e), d(e), 0.0), 15.0, 9999, id++));
+        else if (i < 40)
+            nds.push_back(new ndrnp::Sensor(ndrnp::Coordinate(d(e), d(e), 0.0), 15.0, 20, id++));
+        else
+            nds.push_back(new ndrnp::CDL(ndrnp::Coordinate(d(e), d(e), 0.0), 15.0, 9999, id++));
+    }
+    std::vector<ndrnp::Node*> nodes(nds.begin(), nds.end());
+    ndrnp::Topology  topo(nodes);
+    ndrnp::Workspace ws;
+
+    std::set<ndrnp::size_type> y = ndrnp::anytime_placement(topo,
+        ndrnp::GreedyStrategy(), ws, std::chrono::milliseconds(500), nullptr,
+        [](const ndrnp::AnytimeProgress& p, const std::set<ndrnp::size_type>&) {
+            if (p.phase != ndrnp::anytime_phase::PRUNED)
+                std::cout << p.elapsed.count() << " ms " << phase_name(p.phase)
+                          << ": " << p.relays << " relays, " << p.restarts
+                          << " restarts" << std::endl;
+        });
+    std::cout << "y_hat: ";
+    for (auto &r : y)
+        std::cout << r << ", ";
+    std::cout << std::endl;
+
+    // the caller's own restarts, within a short budget.
+    auto start = std::chrono::steady_clock::now();
+    ndrnp::size_type restarts = 0;
+    y = ndrnp::anytime_placement(topo, ndrnp::LazyGreedyStrategy(), ws,
+        std::chrono::milliseconds(50), nullptr,
+        [&restarts](const ndrnp::AnytimeProgress& p, const std::set<ndrnp::size_type>&) {
+            restarts = p.restarts;
+        }, 1,
+        [](const unsigned& seed, const std::chrono::milliseconds& left) {
+            return ndrnp::RandomStrategy(2, seed, 1, left);
+        });
+    std::chrono::duration<double, std::milli> t = std::chrono::steady_clock::now() - start;
+    std::cout << "custom restarts: " << y.size() << " relays, " << restarts
+              << " restarts, " << t.count() << " ms of 50" << std::endl;
+    return 0;
+}
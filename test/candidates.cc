@@ -0,0 +1,63 @@
+#include <random>
+#include <iostream>
+#include <ctime>
+#include <chrono>
+#include <vector>
+#include <set>
+
+#include "../src/header.h"
+#include "../src/node.h"
+#include "../src/topology.h"
+#include "../src/cover_strategy.h"
+#include "../src/placement.h"
+#include "../src/candidates.h"
+
+std::uniform_real_distribution<double> d(0.0, 100.0);
+std::uniform_real_distribution<double> jitter(-0.5, 0.5);
+std::default_random_engine e(std::time(0));
+
+ndrnp::size_type
+links(const ndrnp::Topology& topo) {
+    ndrnp::size_type n = 0;
+    for (ndrnp::size_type i = 0; i < topo.size(); ++i)
+        n += topo.out(i).size();
+    return n;
+}
+
+void
+report(const char* name, const ndrnp::Topology& topo, const ndrnp::size_type& merged) {
+    ndrnp::Workspace ws;
+    auto start = std::chrono::steady_clock::now();
+    std::set<ndrnp::size_type> y = ndrnp::relay_placement(topo, ndrnp::GreedyStrategy(), ws);
+    std::chrono::duration<double, std::milli> t = std::chrono::steady_clock::now() - start;
+    std::cout << name << ": " << merged << " CDLs merged, " << links(topo) << " links, "
+              << y.size() << " relays, " << t.count() << " ms" << std::endl;
+}
+
+int main(void) {
+    ndrnp::Nodes nds;
+    ndrnp::id_type id = 0;
+
+    // surveyed sites, each giving a cluster of nearly identical CDLs.
+    nds.push_back(new ndrnp::Sink(ndrnp::Coordinate(d(e), d(e), 0.0), 15.0, 9999, id++));
+    for (int i = 0; i < 39; ++i)
+        nds.push_back(new ndrnp::Sensor(ndrnp::Coordinate(d(e), d(e), 0.0), 15.0, 20, id++));
+    for (int i = 0; i < 300; ++i) {
+        double x = d(e), y = d(e);
+        for (int j = 0; j < 3; ++j)
+            nds.push_back(new ndrnp::CDL(ndrnp::Coordinate(x + jitter(e), y + jitter(e), 0.0),
+                                         15.0, 9999, id++));
+    }
+    std::vector<ndrnp::Node*> nodes(nds.begin(), nds.end());
+
+    ndrnp::Topology topo(nodes);
+    report("original", topo, 0);
+    ndrnp::CandidateClasses cls = ndrnp::merge_candidates(topo);
+    report("same links", topo, cls.merged);
+
+    ndrnp::CandidateClasses snapped;
+    std::vector<ndrnp::Node*> kept = ndrnp::snap_candidates(nodes, 2.0, snapped);
+    ndrnp::Topology grid(kept);
+    report("2 m grid", grid, snapped.merged);
+    return 0;
+}
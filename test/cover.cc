@@ -0,0 +1,61 @@
+#include <iostream>
+#include <random>
+#include <ctime>
+#include <chrono>
+#include <set>
+#include <map>
+
+#include "../src/header.h"
+#include "../src/cover.h"
+
+std::default_random_engine e(std::time(0));
+std::uniform_int_distribution<int> elem(0, 39);
+std::uniform_int_distribution<int> len(1, 6);
+
+void
+print_cover(const char* name, const std::set<ndrnp::size_type>& c) {
+    std::cout << name << " (" << c.size() << "): ";
+    for (auto &k : c)
+        std::cout << k << " ";
+    std::cout << std::endl;
+}
+
+int
+main() {
+    ndrnp::Cover<ndrnp::size_type, ndrnp::size_type> cvr;
+
+    for (ndrnp::size_type i = 0; i < 40; ++i)
+        cvr.insert_set(i);
+    // make sure every element can be covered.
+    for (ndrnp::size_type i = 0; i < 40; ++i)
+        cvr.insert_family(i % 25, i);
+    for (ndrnp::size_type k = 25; k < 120; ++k)
+        for (int i = len(e); i > 0; --i)
+            cvr.insert_family(k, elem(e));
+
+    print_cover("greedy", cvr.minimum_set_cover());
+    print_cover("greedy, no redundancy",
+                cvr.eliminate_redundant(cvr.minimum_set_cover()));
+    print_cover("multi-start", cvr.multi_random_set_cover(256, 27, 0,
+                                   std::chrono::milliseconds(500)));
+    print_cover("exact", cvr.exact_set_cover(ndrnp::EXACT_NODE_LIMIT,
+                                   std::chrono::milliseconds(2000)));
+    // relays far from the first candidates cost more to install.
+    std::map<ndrnp::size_type, double> cost;
+    for (ndrnp::size_type k = 0; k < 120; ++k)
+        cost[k] = 1.0 + k / 40.0;
+    print_cover("cost", cvr.cost_set_cover(cost));
+    print_cover("2-fold", cvr.k_set_cover(2));
+    print_cover("random 2-fold", cvr.random_k_set_cover(e, 2));
+
+    ndrnp::Cover<ndrnp::size_type, ndrnp::size_type> reduced = cvr;
+    ndrnp::CoverReduction<ndrnp::size_type> red = reduced.reduce();
+    std::cout << "reduction: " << red.sets_before << " -> " << red.sets_after
+              << " sets, " << red.elements_before << " -> " << red.elements_after
+              << " elements, " << red.forced.size() << " forced, "
+              << red.dominated << " dominated, ratio " << red.ratio() << std::endl;
+    std::set<ndrnp::size_type> c = reduced.minimum_set_cover();
+    c.insert(red.forced.begin(), red.forced.end());
+    print_cover("reduced greedy", c);
+    return 0;
+}
@@ -0,0 +1,48 @@
+#include <random>
+#include <iostream>
+#include <ctime>
+#include <chrono>
+#include <vector>
+#include <set>
+
+#include "../src/header.h"
+#include "../src/node.h"
+#include "../src/topology.h"
+#include "../src/cover_strategy.h"
+#include "../src/placement.h"
+#include "../src/evolution.h"
+
+std::uniform_real_distribution<double> d(0.0, 100.0);
+std::default_random_engine e(std::time(0));
+
+int main(void) {
+    ndrnp::Nodes nds;
+    ndrnp::id_type id = 0;
+
+    for (int i = 0; i < 400; ++i) {
+        if (i < 1)
+            nds.push_back(new ndrnp::Sink(ndrnp::Coordinate(d(e), d(e), 0.0), 15.0, 9999, id++));
+        else if (i < 40)
+            nds.push_back(new ndrnp::Sensor(ndrnp::Coordinate(d(e), d(e), 0.0), 15.0, 20, id++));
+        else
+            nds.push_back(new ndrnp::CDL(ndrnp::Coordinate(d(e), d(e), 0.0), 15.0, 9999, id++));
+    }
+    std::vector<ndrnp::Node*> nodes(nds.begin(), nds.end());
+    ndrnp::Topology  topo(nodes);
+    ndrnp::Workspace ws;
+
+    std::set<ndrnp::size_type> y = ndrnp::relay_placement(topo, ndrnp::GreedyStrategy(), ws);
+    std::cout << "greedy: " << y.size() << " relays, prr "
+              << ndrnp::average_tree_prr(nodes, topo, ws) << std::endl;
+
+    ndrnp::EvolutionConfig cfg;
+    cfg.seed = e();
+    auto start = std::chrono::steady_clock::now();
+    ndrnp::EvolutionResult res = ndrnp::evolve_placement(nodes, topo, cfg);
+    std::chrono::duration<double, std::milli> t = std::chrono::steady_clock::now() - start;
+    std::cout << "evolved: " << res.relays.size() << " relays, prr " << res.fitness.prr
+              << (res.fitness.feasible ? "" : " (infeasible)") << ", "
+              << res.evaluations << " evaluations, " << res.cache_hits
+              << " cache hits, " << t.count() << " ms" << std::endl;
+    return 0;
+}
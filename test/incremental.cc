@@ -0,0 +1,97 @@
+#include <random>
+#include <iostream>
+#include <ctime>
+#include <chrono>
+#include <vector>
+#include <set>
+
+#include "../src/header.h"
+#include "../src/node.h"
+#include "../src/cover_strategy.h"
+#include "../src/placement.h"
+#include "../src/incremental.h"
+
+std::uniform_real_distribution<double> d(0.0, 100.0);
+std::default_random_engine e(std::time(0));
+
+// the placement of a full solve over the current nodes, for
+// comparison.
+std::set<ndrnp::size_type>
+cold(const std::vector<ndrnp::Node*>& nodes, const std::set<ndrnp::size_type>& gone) {
+    std::vector<ndrnp::Node*> alive;
+    for (ndrnp::size_type i = 0; i < nodes.size(); ++i)
+        if (!gone.count(i))
+            alive.push_back(nodes[i]);
+    ndrnp::Topology  topo(alive);
+    ndrnp::Workspace ws;
+    return ndrnp::relay_placement(topo, ndrnp::GreedyStrategy(), ws);
+}
+
+int main(void) {
+    ndrnp::Nodes nds;
+    ndrnp::id_type id = 0;
+
+    for (int i = 0; i < 400; ++i) {
+        if (i < 1)
+            nds.push_back(new ndrnp::Sink(ndrnp::Coordinate(d(e), d(e), 0.0), 15.0, 9999, id++));
+        else if (i < 40)
+            nds.push_back(new ndrnp::Sensor(ndrnp::Coordinate(d(e), d(e), 0.0), 15.0, 20, id++));
+        else
+            nds.push_back(new ndrnp::CDL(ndrnp::Coordinate(d(e), d(e), 0.0), 15.0, 9999, id++));
+    }
+    std::vector<ndrnp::Node*> nodes(nds.begin(), nds.end());
+    std::set<ndrnp::size_type> gone;
+
+    ndrnp::IncrementalSolver solver(nodes);
+    std::set<ndrnp::size_type> y = solver.solve();
+    std::cout << "initial: " << y.size() << " relays" << std::endl;
+
+    std::uniform_int_distribution<ndrnp::size_type> sensor(1, 39);
+    for (int round = 0; round < 5; ++round) {
+        ndrnp::TopologyDelta delta;
+        // a new sensor, a moved one and, every other round, a lost one.
+        nds.push_back(new ndrnp::Sensor(ndrnp::Coordinate(d(e), d(e), 0.0), 15.0, 20, id++));
+        nodes.push_back(nds.back());
+        delta.added.push_back(nds.back());
+        ndrnp::size_type m = sensor(e);
+        while (gone.count(m))
+            m = sensor(e);
+        nodes[m]->set_coordinate(ndrnp::Coordinate(d(e), d(e), 0.0));
+        delta.moved.push_back(m);
+        if (round % 2 == 0) {
+            ndrnp::size_type r = sensor(e);
+            while (gone.count(r) || r == m)
+                r = sensor(e);
+            gone.insert(r);
+            delta.removed.push_back(r);
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        y = solver.resolve(delta);
+        std::chrono::duration<double, std::milli> tw = std::chrono::steady_clock::now() - start;
+
+        start = std::chrono::steady_clock::now();
+        std::set<ndrnp::size_type> c = cold(nodes, gone);
+        std::chrono::duration<double, std::milli> tc = std::chrono::steady_clock::now() - start;
+
+        std::cout << "round " << round << ": warm " << y.size() << " relays ("
+                  << (solver.feasible() ? "feasible" : "infeasible") << "), "
+                  << tw.count() << " ms; cold " << c.size() << " relays, "
+                  << tc.count() << " ms" << std::endl;
+    }
+
+    // moving a CDL in eight relinks and covers everything again.
+    ndrnp::TopologyDelta delta;
+    for (ndrnp::size_type i = 40; i < 400; i += 8) {
+        nodes[i]->set_coordinate(ndrnp::Coordinate(d(e), d(e), 0.0));
+        delta.moved.push_back(i);
+    }
+    auto start = std::chrono::steady_clock::now();
+    y = solver.resolve(delta);
+    std::chrono::duration<double, std::milli> tw = std::chrono::steady_clock::now() - start;
+    std::cout << "large delta: " << y.size() << " relays ("
+              << (solver.feasible() ? "feasible" : "infeasible") << "), "
+              << tw.count() << " ms; cold " << cold(nodes, gone).size() << " relays"
+              << std::endl;
+    return 0;
+}
@@ -0,0 +1,28 @@
+#include <iostream>
+#include <vector>
+#include <chrono>
+
+#include "../src/header.h"
+#include "../src/cover_strategy.h"
+#include "../src/monte_carlo.h"
+
+int main(void) {
+    std::vector<ndrnp::Solver> solvers;
+    solvers.push_back(ndrnp::make_solver("greedy", ndrnp::GreedyStrategy()));
+    solvers.push_back(ndrnp::make_solver("weight", ndrnp::WeightStrategy(4)));
+    solvers.push_back(ndrnp::make_solver("exact",
+                          ndrnp::ExactStrategy(ndrnp::EXACT_NODE_LIMIT,
+                                               std::chrono::milliseconds(100))));
+
+    ndrnp::write_summary_header(std::cout);
+    for (ndrnp::size_type sensors : {20, 40}) {
+        ndrnp::ExperimentPoint pt;
+        pt.counts.sensor_num = sensors;
+        pt.counts.cdl_num = 300;
+        pt.trials = 32;
+        pt.seed = 27;
+        for (auto &ps : ndrnp::monte_carlo(pt, solvers))
+            ndrnp::write_summary(std::cout, ps);
+    }
+    return 0;
+}
@@ -0,0 +1,72 @@
+#include <iostream>
+#include <random>
+#include <chrono>
+#include <vector>
+
+#include "../src/node.h"
+
+/*
+ * Builds and drops the same node sets over and over, with nodes from
+ * new and with nodes in the pool of Nodes, and checks both agree.
+ */
+
+const int ROUNDS = 200;
+const int NODES = 5000;
+
+template <class Fill>
+double
+rounds(ndrnp::Nodes& nds, Fill fill) {
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < ROUNDS; ++r) {
+        std::default_random_engine e(r);
+        nds.clear();
+        fill(nds, e);
+    }
+    std::chrono::duration<double, std::milli> t = std::chrono::steady_clock::now() - start;
+    return t.count();
+}
+
+int
+main() {
+    std::uniform_real_distribution<double> d(0.0, 100.0);
+    ndrnp::Nodes heap, pooled;
+
+    double t_heap = rounds(heap, [&d](ndrnp::Nodes& nds, std::default_random_engine& e) {
+        for (int i = 0; i < NODES; ++i)
+            if (i == 0)
+                nds.push_back(new ndrnp::Sink(ndrnp::Coordinate(d(e), d(e), 0.0), 15.0, 9999, i));
+            else if (i < 500)
+                nds.push_back(new ndrnp::Sensor(ndrnp::Coordinate(d(e), d(e), 0.0), 15.0, 6, i));
+            else
+                nds.push_back(new ndrnp::CDL(ndrnp::Coordinate(d(e), d(e), 0.0), 15.0, 9999, i));
+    });
+    double t_pool = rounds(pooled, [&d](ndrnp::Nodes& nds, std::default_random_engine& e) {
+        nds.reserve(NODES);
+        for (int i = 0; i < NODES; ++i)
+            if (i == 0)
+                nds.emplace_back<ndrnp::Sink>(ndrnp::Coordinate(d(e), d(e), 0.0), 15.0, 9999, i);
+            else if (i < 500)
+                nds.emplace_back<ndrnp::Sensor>(ndrnp::Coordinate(d(e), d(e), 0.0), 15.0, 6, i);
+            else
+                nds.emplace_back<ndrnp::CDL>(ndrnp::Coordinate(d(e), d(e), 0.0), 15.0, 9999, i);
+    });
+
+    // mixing both kinds, and popping either.
+    pooled.push_back(new ndrnp::CDL(ndrnp::Coordinate(1.0, 1.0, 0.0), 15.0, 9999, NODES));
+    pooled.emplace_back<ndrnp::CDL>(ndrnp::Coordinate(2.0, 2.0, 0.0), 15.0, 9999, NODES + 1);
+    pooled.pop_back();
+    pooled.pop_back();
+
+    int bad = heap.size() != pooled.size();
+    const std::vector<ndrnp::Node*>& a = heap, & b = pooled;
+    for (size_t i = 0; !bad && i < a.size(); ++i)
+        if (a[i]->type() != b[i]->type() || a[i]->id() != b[i]->id() ||
+            ndrnp::distance(*a[i], *b[i]) != 0.0)
+            ++bad;
+
+    std::cout << ROUNDS << " rounds of " << NODES << " nodes" << std::endl
+              << "new/delete: " << t_heap << " ms" << std::endl
+              << "pool:       " << t_pool << " ms" << std::endl
+              << "mismatches: " << bad << std::endl;
+    return bad;
+}
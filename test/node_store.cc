@@ -0,0 +1,96 @@
+#include <iostream>
+#include <random>
+#include <chrono>
+#include <vector>
+
+#include "../src/node.h"
+#include "../src/node_store.h"
+#include "../src/topology.h"
+
+/*
+ * Checks the kernels of NodeStore, the links of a Topology (found over
+ * link ranges) and the 2-D coordinates against those over Node objects,
+ * and times the all pairs link test both ways.
+ */
+
+int
+main() {
+    std::default_random_engine e(7);
+    std::uniform_real_distribution<double> d(0, 200);
+    std::vector<ndrnp::Node*> nodes;
+
+    for (int i = 0; i < 2000; ++i) {
+        if (i == 0)
+            nodes.push_back(new ndrnp::Sink(ndrnp::Coordinate(d(e), d(e), 0), 15, 0, i));
+        else if (i < 200)
+            nodes.push_back(new ndrnp::Sensor(ndrnp::Coordinate(d(e), d(e), 0), 15, 6, i));
+        else
+            nodes.push_back(new ndrnp::CDL(ndrnp::Coordinate(d(e), d(e), 0), 15, 0, i));
+    }
+
+    ndrnp::NodeStore st(nodes);
+    size_t bad = 0, links = 0;
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        if (st.index(nodes[i]->id()) != i || st.type(i) != nodes[i]->type())
+            ++bad;
+        for (size_t j = 0; j < nodes.size(); ++j)
+            if (ndrnp::distance(st, i, j) != ndrnp::distance(*nodes[i], *nodes[j]) ||
+                ndrnp::is_neighbor(st, i, j) != ndrnp::is_neighbor(nodes[i], nodes[j]))
+                ++bad;
+    }
+
+    // the topology links over the range prefilter, planar then not.
+    auto start = std::chrono::steady_clock::now();
+    ndrnp::Topology topo(nodes);
+    std::chrono::duration<double, std::milli> t = std::chrono::steady_clock::now() - start;
+    for (size_t i = 0; i < topo.size(); ++i) {
+        links += topo.out(i).size();
+        for (auto &j : topo.out(i))
+            if (ndrnp::is_neighbor(nodes[i], nodes[j]) == -1)
+                ++bad;
+    }
+    std::cout << "nodes: " << nodes.size() << ", links: " << links
+              << ", mismatches: " << bad << ", topology: " << t.count() << " ms" << std::endl;
+
+    std::vector<ndrnp::Node*> hills;
+    for (auto &n : nodes)
+        hills.push_back(new ndrnp::CDL(ndrnp::Coordinate(n->coordinate().x(), n->coordinate().y(), d(e) / 20),
+                                       n->power(), n->hop(), n->id()));
+    ndrnp::Topology topo3(hills);
+    size_t links3 = 0, brute3 = 0;
+    for (size_t i = 0; i < hills.size(); ++i) {
+        links3 += topo3.out(i).size();
+        for (size_t j = 0; j < hills.size(); ++j)
+            brute3 += i != j && ndrnp::is_neighbor(hills[i], hills[j]) != -1;
+    }
+    bad += links3 != brute3;
+    std::cout << "3-D nodes: " << brute3 << " links, topology: " << links3 << std::endl;
+
+    ndrnp::Coordinate2D a(3.0, 4.0), b;
+    ndrnp::Coordinate2F f(3.0f, 4.0f);
+    bad += ndrnp::squared_distance(a, b) != 25.0 || ndrnp::distance(a, b) != 5.0 ||
+           ndrnp::distance(f, ndrnp::Coordinate2F()) != 5.0f ||
+           ndrnp::distance(ndrnp::Coordinate(3.0, 4.0), ndrnp::Coordinate()) != 5.0;
+
+    auto t0 = std::chrono::steady_clock::now();
+    size_t n1 = 0;
+    for (size_t i = 0; i < nodes.size(); ++i)
+        for (size_t j = 0; j < nodes.size(); ++j)
+            n1 += i != j && ndrnp::is_neighbor(nodes[i], nodes[j]) != -1;
+    auto t1 = std::chrono::steady_clock::now();
+    size_t n2 = 0;
+    for (size_t i = 0; i < st.size(); ++i)
+        for (size_t j = 0; j < st.size(); ++j)
+            n2 += i != j && ndrnp::is_neighbor(st, i, j) != -1;
+    auto t2 = std::chrono::steady_clock::now();
+    std::cout << "nodes: " << n1 << " links, "
+              << std::chrono::duration<double>(t1 - t0).count() << "s" << std::endl
+              << "store: " << n2 << " links, "
+              << std::chrono::duration<double>(t2 - t1).count() << "s" << std::endl;
+
+    for (auto &pn : nodes)
+        delete pn;
+    for (auto &pn : hills)
+        delete pn;
+    return bad != 0 || n1 != n2 || n1 != links;
+}
@@ -0,0 +1,42 @@
+#include <random>
+#include <iostream>
+#include <ctime>
+#include <chrono>
+#include <vector>
+
+#include "../src/header.h"
+#include "../src/node.h"
+#include "../src/topology.h"
+#include "../src/pareto.h"
+
+std::uniform_real_distribution<double> d(0.0, 100.0);
+std::default_random_engine e(std::time(0));
+
+int main(void) {
+    ndrnp::Nodes nds;
+    ndrnp::id_type id = 0;
+
+    for (int i = 0; i < 400; ++i) {
+        if (i < 1)
+            nds.push_back(new ndrnp::Sink(ndrnp::Coordinate(d(e), d(e), 0.0), 15.0, 9999, id++));
+        else if (i < 40)
+            nds.push_back(new ndrnp::Sensor(ndrnp::Coordinate(d(e), d(e), 0.0), 15.0, 20, id++));
+        else
+            nds.push_back(new ndrnp::CDL(ndrnp::Coordinate(d(e), d(e), 0.0), 15.0, 9999, id++));
+    }
+    std::vector<ndrnp::Node*> nodes(nds.begin(), nds.end());
+    ndrnp::Topology topo(nodes);
+
+    ndrnp::ParetoConfig cfg;
+    cfg.seed = e();
+    auto start = std::chrono::steady_clock::now();
+    std::vector<ndrnp::ParetoPoint> front = ndrnp::pareto_placements(nodes, topo, cfg);
+    std::chrono::duration<double, std::milli> t = std::chrono::steady_clock::now() - start;
+
+    std::cout << front.size() << " non-dominated placements, " << t.count() << " ms"
+              << std::endl << "relays,delay,prr,energy,source" << std::endl;
+    for (auto &p : front)
+        std::cout << p.count << "," << p.delay << "," << p.prr << "," << p.energy
+                  << "," << p.source << std::endl;
+    return 0;
+}
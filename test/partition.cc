@@ -0,0 +1,61 @@
+#include <random>
+#include <iostream>
+#include <ctime>
+#include <chrono>
+#include <vector>
+#include <set>
+
+#include "../src/header.h"
+#include "../src/node.h"
+#include "../src/cover_strategy.h"
+#include "../src/placement.h"
+#include "../src/partition.h"
+
+// a field of side 100 * scale with the node density of the other
+// tests, the sink in the middle and hop constraints growing with
+// the field.
+void
+random_field(const int& scale, std::default_random_engine& e, ndrnp::Nodes& nds) {
+    std::uniform_real_distribution<double> d(0.0, 100.0 * scale);
+    ndrnp::id_type id = 0;
+
+    nds.push_back(new ndrnp::Sink(ndrnp::Coordinate(50.0 * scale, 50.0 * scale, 0.0),
+                                  15.0, 9999, id++));
+    for (int i = 0; i < 39 * scale * scale; ++i)
+        nds.push_back(new ndrnp::Sensor(ndrnp::Coordinate(d(e), d(e), 0.0), 15.0, 20 * scale, id++));
+    for (int i = 0; i < 360 * scale * scale; ++i)
+        nds.push_back(new ndrnp::CDL(ndrnp::Coordinate(d(e), d(e), 0.0), 15.0, 9999, id++));
+}
+
+int main(void) {
+    std::default_random_engine e(std::time(0));
+
+    // the quality gap against the monolithic solver, on sizes where
+    // both run.
+    for (int scale = 1; scale <= 3; ++scale) {
+        ndrnp::Nodes nds;
+        random_field(scale, e, nds);
+        std::vector<ndrnp::Node*> nodes(nds.begin(), nds.end());
+
+        auto start = std::chrono::steady_clock::now();
+        ndrnp::Topology  topo(nodes);
+        ndrnp::Workspace ws;
+        std::set<ndrnp::size_type> y = ndrnp::relay_placement(topo, ndrnp::GreedyStrategy(), ws);
+        std::chrono::duration<double, std::milli> tm = std::chrono::steady_clock::now() - start;
+
+        ndrnp::PartitionConfig cfg;
+        cfg.tiles = 4 * scale;
+        start = std::chrono::steady_clock::now();
+        ndrnp::PartitionResult res = ndrnp::partitioned_placement(nodes,
+                                         ndrnp::GreedyStrategy(), cfg);
+        std::chrono::duration<double, std::milli> tp = std::chrono::steady_clock::now() - start;
+
+        std::cout << nodes.size() << " nodes: monolithic " << y.size() << " relays, "
+                  << tm.count() << " ms; " << res.tiles << " tiles "
+                  << res.relays.size() << " relays (" << res.merged << " merged, " << res.tile_relays
+                  << " before stitching, " << res.retries << " retries, "
+                  << (res.feasible ? "feasible" : "infeasible") << "), "
+                  << tp.count() << " ms" << std::endl;
+    }
+    return 0;
+}
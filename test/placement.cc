@@ -0,0 +1,137 @@
+#include <random>
+#include <iostream>
+#include <ctime>
+#include <chrono>
+#include <vector>
+#include <map>
+#include <set>
+
+#include "../src/header.h"
+#include "../src/node.h"
+#include "../src/cover_strategy.h"
+#include "../src/placement.h"
+#include "../src/thread_pool.h"
+
+std::uniform_real_distribution<double> d(0.0, 100.0);
+unsigned seed = std::time(0);
+
+// the solver changes node powers, so every strategy gets its own
+// copy of the same random topology.
+void
+random_nodes(ndrnp::Nodes& nds) {
+    std::default_random_engine e(seed);
+    ndrnp::id_type id = 0;
+
+    for (int i = 0; i < 400; ++i) {
+        if (i < 1)
+            nds.push_back(new ndrnp::Sink(ndrnp::Coordinate(d(e), d(e), 0.0), 15.0, 9999, id++));
+        else if (i < 40)
+            nds.push_back(new ndrnp::Sensor(ndrnp::Coordinate(d(e), d(e), 0.0), 15.0, 20, id++));
+        else
+            nds.push_back(new ndrnp::CDL(ndrnp::Coordinate(d(e), d(e), 0.0), 15.0, 9999, id++));
+    }
+}
+
+template <class Strategy>
+void
+run(const char* name, const Strategy& strategy) {
+    ndrnp::Nodes nds;
+    random_nodes(nds);
+    std::vector<ndrnp::Node*> nodes(nds.begin(), nds.end());
+
+    auto start = std::chrono::steady_clock::now();
+    std::set<ndrnp::size_type> y = ndrnp::relay_placement(nodes, strategy);
+    std::chrono::duration<double, std::milli> t = std::chrono::steady_clock::now() - start;
+    std::cout << name << ": " << y.size() << " relays, " << t.count() << " ms" << std::endl;
+}
+
+// concurrent solves sharing one read-only topology, each with its
+// own workspace.
+void
+run_shared(const ndrnp::size_type& runs) {
+    ndrnp::Nodes nds;
+    random_nodes(nds);
+    std::vector<ndrnp::Node*> nodes(nds.begin(), nds.end());
+    const ndrnp::Topology topo(nodes);
+    ndrnp::ThreadPool pool;
+    std::vector<std::future<ndrnp::size_type>> res;
+
+    for (ndrnp::size_type i = 0; i < runs; ++i)
+        res.push_back(pool.submit([&topo, i]() {
+            ndrnp::Workspace ws;
+            return ndrnp::relay_placement(topo,
+                       ndrnp::RandomStrategy(16, seed + i, 1), ws).size();
+        }));
+    std::cout << "shared topology:";
+    for (auto &r : res)
+        std::cout << " " << r.get();
+    std::cout << " relays" << std::endl;
+}
+
+// repeated solves reusing one context.
+void
+run_batch(const ndrnp::size_type& runs) {
+    ndrnp::SolverContext ctx;
+
+    std::cout << "batch:";
+    for (ndrnp::size_type i = 0; i < runs; ++i) {
+        ndrnp::Nodes nds;
+        random_nodes(nds);
+        std::vector<ndrnp::Node*> nodes(nds.begin(), nds.end());
+        std::cout << " " << ctx.solve(nodes, ndrnp::GreedyStrategy()).size();
+    }
+    std::cout << " relays" << std::endl;
+}
+
+// CDLs on no hop feasible path, dropped before solving: a chain of
+// four CDLs from the sink to a sensor allowed five hops, a branch of
+// three CDLs off the sink (six hops or more from the sensor) and two
+// CDLs the sink does not reach. Exactly the five last ones go, and
+// the placement stays the chain.
+bool
+run_pruned(void) {
+    const double r = 0.9 * ndrnp::PrrModel().range(15.0, ndrnp::PRR_CONSTRAINT);
+    ndrnp::Nodes nds;
+    ndrnp::id_type id = 0;
+
+    nds.push_back(new ndrnp::Sink(ndrnp::Coordinate(0.0, 0.0, 0.0), 15.0, 9999, id++));
+    nds.push_back(new ndrnp::Sensor(ndrnp::Coordinate(5 * r, 0.0, 0.0), 15.0, 5, id++));
+    for (int k = 1; k <= 4; ++k)
+        nds.push_back(new ndrnp::CDL(ndrnp::Coordinate(k * r, 0.0, 0.0), 15.0, 9999, id++));
+    for (int k = 1; k <= 3; ++k)
+        nds.push_back(new ndrnp::CDL(ndrnp::Coordinate(0.0, k * r, 0.0), 15.0, 9999, id++));
+    for (int k = 0; k < 2; ++k)
+        nds.push_back(new ndrnp::CDL(ndrnp::Coordinate(100 * r, (100 + k) * r, 0.0),
+                                     15.0, 9999, id++));
+    std::vector<ndrnp::Node*> nodes(nds.begin(), nds.end());
+
+    ndrnp::Topology  full(nodes), topo(nodes);
+    ndrnp::Workspace ws;
+    ndrnp::size_type removed = ndrnp::prune_candidates(topo, ws);
+    std::set<ndrnp::size_type> before = ndrnp::relay_placement(full, ndrnp::GreedyStrategy(), ws);
+    std::set<ndrnp::size_type> after = ndrnp::relay_placement(topo, ndrnp::GreedyStrategy(), ws);
+    bool ok = removed == 5 && before == after && after == std::set<ndrnp::size_type>{2, 3, 4, 5};
+
+    std::cout << "pruned candidates: " << removed << " of 9, " << before.size()
+              << " relays before, " << after.size() << " after"
+              << (ok ? "" : " (unexpected)") << std::endl;
+    return ok;
+}
+
+int main(void) {
+    std::map<ndrnp::size_type, double> cost;
+    for (ndrnp::size_type i = 40; i < 400; ++i)
+        cost[i] = 1.0 + (i % 3);
+
+    run("greedy", ndrnp::GreedyStrategy());
+    run("lazy greedy", ndrnp::LazyGreedyStrategy());
+    run("weight", ndrnp::WeightStrategy(4));
+    run("cost", ndrnp::CostStrategy(cost));
+    run("random", ndrnp::RandomStrategy(64, seed));
+    run("exact", ndrnp::ExactStrategy(ndrnp::EXACT_NODE_LIMIT,
+                                      std::chrono::milliseconds(200)));
+    run("2-fold", ndrnp::KFoldStrategy(2));
+    run_shared(8);
+    run_batch(4);
+    return run_pruned() ? 0 : 1;
+}
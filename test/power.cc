@@ -0,0 +1,77 @@
+#include <random>
+#include <iostream>
+#include <ctime>
+#include <vector>
+#include <map>
+#include <set>
+
+#include "../src/header.h"
+#include "../src/node.h"
+#include "../src/topology.h"
+#include "../src/cover_strategy.h"
+#include "../src/placement.h"
+#include "../src/power.h"
+
+std::uniform_real_distribution<double> d(0.0, 100.0);
+std::default_random_engine e(std::time(0));
+
+int main(void) {
+    ndrnp::Nodes nds;
+    ndrnp::id_type id = 0;
+
+    for (int i = 0; i < 400; ++i) {
+        if (i < 1)
+            nds.push_back(new ndrnp::Sink(ndrnp::Coordinate(d(e), d(e), 0.0), 15.0, 9999, id++));
+        else if (i < 40)
+            nds.push_back(new ndrnp::Sensor(ndrnp::Coordinate(d(e), d(e), 0.0), 15.0, 20, id++));
+        else
+            nds.push_back(new ndrnp::CDL(ndrnp::Coordinate(d(e), d(e), 0.0), 15.0, 9999, id++));
+    }
+    std::vector<ndrnp::Node*> nodes(nds.begin(), nds.end());
+    ndrnp::Topology  topo(nodes);
+    ndrnp::Workspace ws;
+
+    std::set<ndrnp::size_type> y = ndrnp::relay_placement(topo, ndrnp::GreedyStrategy(), ws);
+    std::vector<ndrnp::Node::power_type> power = ndrnp::assign_power(nodes, topo, ws);
+
+    std::map<ndrnp::Node::power_type, ndrnp::size_type> count;
+    for (ndrnp::size_type i = 0; i < nodes.size(); ++i) {
+        nodes[i]->set_power(power[i]);
+        if (power[i] > 0.0)
+            ++count[power[i]];
+    }
+    std::cout << y.size() << " relays, power levels:";
+    for (auto &c : count)
+        std::cout << " " << c.first << " dBm x " << c.second;
+    std::cout << std::endl;
+
+    // every uplink of the tree must hold at the assigned powers, so
+    // the sensors still reach the sink within their hop constraints.
+    std::vector<ndrnp::size_type> parent = ndrnp::routing_tree(nodes, topo, ws);
+    bool kept = true;
+    for (ndrnp::size_type i = 0; i < nodes.size(); ++i)
+        if (parent[i] != topo.size() &&
+            ndrnp::is_neighbor(nodes[i], nodes[parent[i]]) == -1)
+            kept = false;
+    std::cout << (kept ? "feasible" : "infeasible") << std::endl;
+
+    // a parent close to the sink with two far children: it only
+    // needs the level of its own short uplink, weaker than the one
+    // its children need.
+    ndrnp::Nodes star;
+    star.push_back(new ndrnp::Sink(ndrnp::Coordinate(0.0, 0.0, 0.0), 1.0, 9999, 0));
+    star.push_back(new ndrnp::Sensor(ndrnp::Coordinate(5.0, 0.0, 0.0), 1.0, 20, 1));
+    star.push_back(new ndrnp::Sensor(ndrnp::Coordinate(24.0, 0.0, 0.0), 1.0, 20, 2));
+    star.push_back(new ndrnp::Sensor(ndrnp::Coordinate(22.0, 10.0, 0.0), 1.0, 20, 3));
+    std::vector<ndrnp::Node*> leaves(star.begin(), star.end());
+    ndrnp::Topology  tree(leaves);
+    ndrnp::Workspace tw;
+    tw.reset(tree);
+    std::vector<ndrnp::Node::power_type> level = ndrnp::assign_power(leaves, tree, tw);
+
+    std::cout << "parent " << level[1] << " dBm, children " << level[2] << " and "
+              << level[3] << " dBm: "
+              << (level[1] > level[2] && level[1] > level[3] ? "weaker" : "not weaker")
+              << std::endl;
+    return 0;
+}
@@ -0,0 +1,36 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+#include "../src/header.h"
+#include "../src/sweep.h"
+
+// usage: sweep [config], the config defaults to sweep.cfg.
+int main(int argc, char* argv[]) {
+    std::ifstream in(argc > 1 ? argv[1] : "sweep.cfg");
+
+    if (!in) {
+        std::cerr << "cannot open config file" << std::endl;
+        return 1;
+    }
+    // counts and hop constraints that would wrap or truncate are
+    // rejected as the points are built.
+    for (const char* bad : {"sensor_num = -1", "cdl_num = 2.5", "hop = 0",
+                            "hop = 10000"}) {
+        std::istringstream is(bad);
+        try {
+            ndrnp::sweep_points(ndrnp::read_sweep_config(is));
+            std::cout << bad << ": accepted" << std::endl;
+        } catch (std::range_error& e) {
+            std::cout << bad << ": " << e.what() << std::endl;
+        }
+    }
+    try {
+        ndrnp::sweep(ndrnp::read_sweep_config(in), std::cout);
+    } catch (std::range_error& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}